@@ -0,0 +1,154 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/BasicByteArray.h>
+#include <stdlib.h>
+
+#if defined(CC7_WINDOWS)
+#include <malloc.h>
+#endif
+
+namespace cc7
+{
+namespace detail
+{
+    /**
+     Returns |size| rounded up to the multiple of |alignment|. Unlike the
+     utilities::AlignValue(), returns 0 for 0.
+     */
+    inline size_t AlignedPaddedSize(size_t size, size_t alignment)
+    {
+        return (size + (alignment - 1)) & ~(alignment - 1);
+    }
+
+    /**
+     The AlignedCleanupAllocator is std::allocator, which returns memory aligned
+     to |Alignment| bytes. Like the CleanupAllocator, the memory is securely
+     cleaned before the deallocation.
+
+     If |Padding| is true, then each allocated block is extended to the whole
+     multiple of |Alignment| and the padding bytes are set to zero. So, it's safe
+     to read the whole aligned block, even behind the vector's capacity.
+     */
+    template <class T, size_t Alignment, bool Padding = true>
+    class AlignedCleanupAllocator : public std::allocator<T>
+    {
+    public:
+
+        static_assert(Alignment >= sizeof(void*), "Alignment must be at least the size of pointer");
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be power of 2");
+
+        template <class U> struct rebind
+        {
+            typedef AlignedCleanupAllocator<U, Alignment, Padding> other;
+        };
+
+        AlignedCleanupAllocator() throw()
+        {
+        }
+
+        AlignedCleanupAllocator(const AlignedCleanupAllocator &) throw()
+        {
+        }
+
+        template <class U> AlignedCleanupAllocator(const AlignedCleanupAllocator<U, Alignment, Padding> &) throw()
+        {
+        }
+
+        /**
+         Returns number of bytes actually allocated for |n| objects.
+         */
+        static size_t allocationSize(size_t n)
+        {
+            const size_t size = n * sizeof(T);
+            return Padding ? AlignedPaddedSize(size, Alignment) : size;
+        }
+
+        T * allocate(size_t n)
+        {
+            const size_t size = allocationSize(n);
+            void * p = nullptr;
+#if defined(CC7_WINDOWS)
+            p = _aligned_malloc(size > 0 ? size : Alignment, Alignment);
+#else
+            if (posix_memalign(&p, Alignment, size > 0 ? size : Alignment) != 0) {
+                p = nullptr;
+            }
+#endif
+            if (!p) {
+                ExceptionsWrapper<cc7::byte>::allocation_error();
+                return nullptr;
+            }
+            if (Padding) {
+                // Clear padding, to make over-reads deterministic.
+                const size_t used = n * sizeof(T);
+                memset(static_cast<cc7::byte*>(p) + used, 0, size - used);
+            }
+            return static_cast<T*>(p);
+        }
+
+        void deallocate(T * p, size_t n)
+        {
+            CC7_SecureClean(p, allocationSize(n));
+#if defined(CC7_WINDOWS)
+            _aligned_free(p);
+#else
+            free(p);
+#endif
+        }
+    };
+
+} // cc7::detail
+
+    /**
+     The AlignedByteArray is a ByteArray-like container, which guarantees that
+     its data() pointer is aligned to |Alignment| bytes. The default 64 bytes
+     alignment matches the cache line size and the widest vector registers.
+
+     If |Padding| is true, then the allocated memory is always extended to
+     the whole multiple of |Alignment|, so the vectorized code can safely process
+     the last incomplete block without a scalar tail loop. Use the PaddedSize()
+     function to determine how many bytes are accessible behind the data() pointer.
+     */
+    template <size_t Alignment = 64, bool Padding = true>
+    using AlignedByteArray = BasicByteArray<detail::AlignedCleanupAllocator<cc7::byte, Alignment, Padding>>;
+
+    /**
+     Returns number of bytes which can be safely read from the array's data()
+     pointer. If the array is padded, then the value is greater or equal than
+     the array's capacity, otherwise it's equal to the capacity.
+     */
+    template <size_t Alignment, bool Padding>
+    inline size_t PaddedSize(const AlignedByteArray<Alignment, Padding> & array)
+    {
+        if (array.capacity() == 0) {
+            return 0;
+        }
+        return detail::AlignedCleanupAllocator<cc7::byte, Alignment, Padding>::allocationSize(array.capacity());
+    }
+
+    /**
+     Returns true if |ptr| is aligned to |Alignment| bytes.
+     */
+    template <size_t Alignment>
+    inline bool IsAligned(const void * ptr)
+    {
+        return (reinterpret_cast<uintptr_t>(ptr) & (Alignment - 1)) == 0;
+    }
+
+} // cc7
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/Platform.h>
+
+//
+// Allocation statistics are an opt-in feature. You have to define
+// ENABLE_CC7_ALLOCATION_STATS macro for the whole build (library and
+// its users), otherwise all hooks are empty inline functions and the
+// snapshot is always empty.
+//
+
+namespace cc7
+{
+namespace debug
+{
+    /**
+     The AllocationStatistics structure contains a snapshot of counters collected
+     by the CleanupAllocator, and by the secureClear() method of ByteArray.
+     */
+    struct AllocationStatistics
+    {
+        /**
+         Number of buckets in size histogram. The bucket at index i counts
+         allocations of up to (16 << i) bytes. The last bucket counts all
+         larger allocations.
+         */
+        static const size_t HISTOGRAM_SIZE = 16;
+
+        /// Number of allocations.
+        U64     allocations;
+        /// Number of deallocations.
+        U64     deallocations;
+        /// Total number of allocated bytes.
+        U64     allocated_bytes;
+        /// Total number of deallocated bytes.
+        U64     deallocated_bytes;
+        /// Total number of securely cleaned bytes, by the allocator and by secureClear().
+        U64     wiped_bytes;
+        /// Number of secureClear() calls.
+        U64     secure_clears;
+        /// Number of buffer reallocations, caused by ByteArray growth.
+        U64     reallocations;
+        /// Number of bytes allocated at the time of snapshot.
+        U64     live_bytes;
+        /// Maximum number of bytes allocated at the same time.
+        U64     peak_live_bytes;
+        /// Histogram of allocation sizes.
+        U64     size_histogram[HISTOGRAM_SIZE];
+    };
+
+    /**
+     Returns true if the library was compiled with the allocation statistics.
+     */
+    bool HasAllocationStatistics();
+
+    /**
+     Returns snapshot of allocation statistics, aggregated over all threads.
+     The counters from already finished threads are also included. If the
+     statistics are not compiled in, then returns zeroed structure.
+
+     The snapshot is consistent per counter, but not between counters,
+     because other threads may allocate while the snapshot is collected.
+     */
+    AllocationStatistics GetAllocationStatistics();
+
+    /**
+     Sets all counters to zero. The peak of live bytes is set to the current
+     number of live bytes. Note that the reset is not atomic against allocations
+     made in other threads at the same time.
+     */
+    void ResetAllocationStatistics();
+
+} // cc7::debug
+
+namespace detail
+{
+    //
+    // Hooks for the allocators. Each thread updates its own set of counters,
+    // so the hot path takes no locks. Only the number of live bytes is a shared
+    // atomic counter, because the peak value cannot be computed from per-thread
+    // counters.
+    //
+
+#if defined(ENABLE_CC7_ALLOCATION_STATS)
+
+    void AllocationStats_OnAllocate(size_t size);
+    void AllocationStats_OnDeallocate(size_t size);
+    void AllocationStats_OnWipe(size_t size, bool secure_clear);
+    void AllocationStats_OnReallocation();
+
+    /**
+     The GrowthObserver counts a reallocation, if the container's capacity
+     has changed during the observer's lifetime.
+     */
+    template <class Container>
+    class GrowthObserver
+    {
+    public:
+        GrowthObserver(const Container & c) :
+            _c(c),
+            _capacity(c.capacity())
+        {
+        }
+        ~GrowthObserver()
+        {
+            if (_capacity != 0 && _c.capacity() > _capacity) {
+                AllocationStats_OnReallocation();
+            }
+        }
+    private:
+        const Container &   _c;
+        size_t              _capacity;
+    };
+
+#else
+
+    inline void AllocationStats_OnAllocate(size_t)
+    {
+    }
+    inline void AllocationStats_OnDeallocate(size_t)
+    {
+    }
+    inline void AllocationStats_OnWipe(size_t, bool)
+    {
+    }
+    inline void AllocationStats_OnReallocation()
+    {
+    }
+
+    template <class Container>
+    class GrowthObserver
+    {
+    public:
+        GrowthObserver(const Container &)
+        {
+        }
+    };
+
+#endif // defined(ENABLE_CC7_ALLOCATION_STATS)
+
+} // cc7::detail
+} // cc7
@@ -20,6 +20,8 @@
 
 namespace cc7
 {
+    class ByteChain;
+    
     /**
      Converts input byte range ino Base32 encoded string. The |use_padding| parameter
      determines whether the output string will contain padding characted '='.
@@ -39,6 +41,19 @@ namespace cc7
      */
     bool Base32_Decode(const std::string & in_string, bool require_padding, ByteArray & out_bytes);
     
+    /**
+     Converts all segments from the chain into one Base32 encoded string. The chain is not
+     flattened, the encoder processes segment by segment. The function always returns true.
+     */
+    bool Base32_Encode(const ByteChain & in_chain, bool use_padding, std::string & out_string);
+    
+    /**
+     Converts Base32 encoded string and appends the decoded bytes to the chain, as a new
+     owned segment. Returns false if the string is not a valid Base32 string. In this case,
+     the chain is not modified.
+     */
+    bool Base32_Decode(const std::string & in_string, bool require_padding, ByteChain & out_chain);
+    
     /**
      Converts input byte range into Base32 encoded string. This is just the convenient function to Base32_Encode().
      */
@@ -20,6 +20,9 @@
 
 namespace cc7
 {
+    class ByteChain;
+    class MutableByteRange;
+    
     /**
      Converts input byte range into Base64 encoded string. The function returns false
      only if you provide an invalid |wrap_size| parameter.
@@ -38,6 +41,33 @@ namespace cc7
      */
     bool Base64_Decode(const std::string & in_string, size_t wrap_size, ByteArray & out_data);
     
+    /**
+     Converts Base64 encoded string into the provided buffer and sets |out_size| to the number
+     of decoded bytes. The function doesn't allocate memory. The buffer of (in_string.size() / 4) * 3
+     bytes is always large enough.
+     
+     Returns false if the string is not a valid Base64 string, or if the buffer is too small.
+     In this case, the content of the buffer is undefined and |out_size| is set to 0.
+     */
+    bool Base64_Decode(const std::string & in_string, size_t wrap_size, MutableByteRange out_buffer, size_t & out_size);
+    
+    /**
+     Converts all segments from the chain into one Base64 encoded string. The chain is not
+     flattened, the encoder processes segment by segment. The function returns false only
+     if you provide an invalid |wrap_size| parameter.
+     */
+    bool Base64_Encode(const ByteChain & in_chain, size_t wrap_size, std::string & out_string);
+    
+    /**
+     Converts Base64 encoded string and appends the decoded bytes to the chain, as a new
+     owned segment. Unlike the variant with ByteArray, the chain is not cleared, so you can
+     use this function to assemble a message from multiple sources.
+     
+     Returns false if the string is not a valid Base64 string. In this case, the chain
+     is not modified.
+     */
+    bool Base64_Decode(const std::string & in_string, size_t wrap_size, ByteChain & out_chain);
+    
     /**
      Converts input byte range into Base64 encoded string. This variant of encoding function may be
      easier to use, but unlike the Base64_Encode(), you are not able to determine whether
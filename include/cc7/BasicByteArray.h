@@ -0,0 +1,147 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteRange.h>
+
+namespace cc7
+{
+    //
+    // The BasicByteArray template is a version of ByteArray class, which
+    // allows you to specify a custom allocator for the underlying vector.
+    // The interface for interaction with ByteRange is the same as in ByteArray.
+    //
+    // Note that all allocators used with this template should securely clean
+    // the memory before it's returned back to the system.
+    //
+
+    template <class Allocator>
+    class BasicByteArray : public std::vector<cc7::byte, Allocator>
+    {
+    public:
+
+        typedef std::vector<cc7::byte, Allocator> parent_class;
+
+        typedef typename parent_class::value_type       value_type;
+        typedef typename parent_class::size_type        size_type;
+        typedef typename parent_class::const_pointer    const_pointer;
+        typedef typename parent_class::iterator         iterator;
+        typedef typename parent_class::const_iterator   const_iterator;
+
+        using parent_class::parent_class;
+        using parent_class::assign;
+        using parent_class::insert;
+
+        BasicByteArray()
+        {
+        }
+
+        //
+        // Interaction with ByteRange class
+        //
+        BasicByteArray(const ByteRange & range) : parent_class(range.begin(), range.end())
+        {
+        }
+
+        BasicByteArray & operator=(const ByteRange & range)
+        {
+            parent_class::assign(range.begin(), range.end());
+            return *this;
+        }
+
+        void assign(const ByteRange & range)
+        {
+            parent_class::assign(range.begin(), range.end());
+        }
+
+        BasicByteArray & append(const ByteRange & range)
+        {
+            parent_class::insert(parent_class::end(), range.begin(), range.end());
+            return *this;
+        }
+
+        iterator insert(const_iterator position, const ByteRange & range)
+        {
+            return parent_class::insert(position, range.begin(), range.end());
+        }
+
+        ByteRange byteRange() const
+        {
+            return ByteRange(parent_class::data(), parent_class::size());
+        }
+
+        operator ByteRange () const
+        {
+            return byteRange();
+        }
+
+        //
+        // Appending
+        //
+
+        BasicByteArray & append(const value_type& val)
+        {
+            parent_class::push_back(val);
+            return *this;
+        }
+
+        BasicByteArray & append(size_type n, const value_type& val)
+        {
+            parent_class::insert(parent_class::end(), n, val);
+            return *this;
+        }
+
+        template <class InputIterator>
+        BasicByteArray & append(InputIterator first, InputIterator last)
+        {
+            parent_class::insert(parent_class::end(), first, last);
+            return *this;
+        }
+
+        BasicByteArray & append(std::initializer_list<value_type> il)
+        {
+            parent_class::insert(parent_class::end(), il);
+            return *this;
+        }
+
+        BasicByteArray & append(const_pointer p, size_type size)
+        {
+            parent_class::insert(parent_class::end(), p, p + size);
+            return *this;
+        }
+
+        //
+        // Other custom methods
+        //
+
+        void secureClear()
+        {
+            CC7_SecureClean(parent_class::data(), parent_class::capacity());
+            parent_class::clear();
+        }
+    };
+
+    /**
+     Creates a new ByteRange object from given BasicByteArray.
+     */
+    template <class Allocator>
+    inline ByteRange MakeRange(const BasicByteArray<Allocator> & array)
+    {
+        return array.byteRange();
+    }
+
+} // cc7
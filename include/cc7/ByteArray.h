@@ -18,6 +18,7 @@
 
 #include <cc7/ByteRange.h>
 #include <cc7/detail/CleanupAllocator.h>
+#include <cc7/detail/ConcatExpression.h>
 
 namespace cc7
 {
@@ -36,13 +37,51 @@ namespace cc7
         typedef std::vector<cc7::byte, detail::CleanupAllocator<cc7::byte>> parent_class;
         
         using parent_class::parent_class;
-        using parent_class::assign;
-        using parent_class::insert;
         
         ByteArray()
         {
         }
         
+        // The allocator doesn't initialize the elements, so the constructors
+        // with the size must provide the zero value explicitly.
+        explicit ByteArray(size_type n) : parent_class(n, 0)
+        {
+        }
+        
+        ByteArray(size_type n, const allocator_type & a) : parent_class(n, 0, a)
+        {
+        }
+        
+        ByteArray(const ByteArray & other) = default;
+        ByteArray(ByteArray && other) = default;
+        
+        ByteArray & operator=(const ByteArray & other)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            // The buffer may be reused for a shorter content.
+            _updateWatermark();
+            parent_class::operator=(other);
+            return *this;
+        }
+        
+        ByteArray & operator=(ByteArray && other) noexcept
+        {
+            // The current buffer is released by the vector, so the watermark
+            // is taken from the other array, together with its buffer.
+            parent_class::operator=(std::move(other));
+            _watermark = other._watermark;
+            other._watermark = 0;
+            return *this;
+        }
+        
+        ByteArray & operator=(std::initializer_list<value_type> il)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
+            parent_class::operator=(il);
+            return *this;
+        }
+        
         
         //
         // Interaction with ByteRange class
@@ -53,26 +92,94 @@ namespace cc7
         
         ByteArray& operator=(const ByteRange& range)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
             parent_class::assign(range.begin(), range.end());
             return *this;
         }
         
         void assign(const ByteRange & range)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
             parent_class::assign(range.begin(), range.end());
         }
         
+        void assign(size_type n, const value_type & val)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
+            parent_class::assign(n, val);
+        }
+        
+        template <class InputIterator, class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+        void assign(InputIterator first, InputIterator last)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
+            parent_class::assign(first, last);
+        }
+        
+        void assign(std::initializer_list<value_type> il)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
+            parent_class::assign(il);
+        }
+        
         ByteArray & append(const ByteRange & range)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
             parent_class::insert(end(), range.begin(), range.end());
             return *this;
         }
         
         iterator insert(const_iterator position, const ByteRange & range)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
             return parent_class::insert(position, range.begin(), range.end());
         }
         
+        //
+        // Interaction with concatenation expressions, produced by
+        // operator+ between ByteRange objects and bytes. The array
+        // is allocated once, for the whole expression.
+        //
+        template <class L, class R>
+        ByteArray(const detail::ConcatExpression<L, R> & expr)
+        {
+            parent_class::reserve(expr.size());
+            expr.appendTo(*this);
+        }
+        
+        template <class L, class R>
+        ByteArray & operator=(const detail::ConcatExpression<L, R> & expr)
+        {
+            // The expression may capture this array, so build a new one.
+            ByteArray tmp(expr);
+            swap(tmp);
+            return *this;
+        }
+        
+        template <class L, class R>
+        ByteArray & append(const detail::ConcatExpression<L, R> & expr)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            const size_type required = size() + expr.size();
+            if (required > capacity()) {
+                // Reallocation is required. The expression may capture this array,
+                // so the content is moved to the new buffer after the evaluation.
+                ByteArray tmp;
+                tmp.reserve(required);
+                tmp.insert(tmp.end(), begin(), end());
+                expr.appendTo(tmp);
+                swap(tmp);
+            } else {
+                expr.appendTo(*this);
+            }
+            return *this;
+        }
+        
         ByteRange byteRange() const
         {
             return ByteRange(data(), size());
@@ -92,6 +199,7 @@ namespace cc7
         // single element, the same as push_back()
         ByteArray & append(const value_type& val)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
             parent_class::push_back(val);
             return *this;
         }
@@ -99,6 +207,7 @@ namespace cc7
         // fill
         ByteArray & append(size_type n, const value_type& val)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
             parent_class::insert(end(), n, val);
             return *this;
         }
@@ -107,6 +216,7 @@ namespace cc7
         template <class InputIterator>
         ByteArray & append(InputIterator first, InputIterator last)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
             parent_class::insert(end(), first, last);
             return *this;
         }
@@ -114,6 +224,7 @@ namespace cc7
         // initializer list
         ByteArray & append(std::initializer_list<value_type> il)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
             parent_class::insert(end(), il);
             return *this;
         }
@@ -121,18 +232,199 @@ namespace cc7
         // append [pointer, size]
         ByteArray & append(const_pointer p, size_type size)
         {
+            detail::GrowthObserver<ByteArray> observer(*this);
             parent_class::insert(end(), p, p + size);
             return *this;
         }
         
+        //
+        // Methods from std::vector, which may grow the array. All of them
+        // are wrapped, so the growth is visible in the allocation statistics.
+        //
+        
+        void push_back(const value_type & val)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            parent_class::push_back(val);
+        }
+        
+        template <class... Args>
+        void emplace_back(Args&&... args)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            parent_class::emplace_back(std::forward<Args>(args)...);
+        }
+        
+        // The allocator doesn't initialize the elements, so the emplace methods
+        // without the value must provide the zero explicitly.
+        void emplace_back()
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            parent_class::emplace_back(value_type(0));
+        }
+        
+        template <class... Args>
+        iterator emplace(const_iterator position, Args&&... args)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            return parent_class::emplace(position, std::forward<Args>(args)...);
+        }
+        
+        iterator emplace(const_iterator position)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            return parent_class::emplace(position, value_type(0));
+        }
+        
+        iterator insert(const_iterator position, const value_type & val)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            return parent_class::insert(position, val);
+        }
+        
+        iterator insert(const_iterator position, size_type n, const value_type & val)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            return parent_class::insert(position, n, val);
+        }
+        
+        template <class InputIterator, class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+        iterator insert(const_iterator position, InputIterator first, InputIterator last)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            return parent_class::insert(position, first, last);
+        }
+        
+        iterator insert(const_iterator position, std::initializer_list<value_type> il)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            return parent_class::insert(position, il);
+        }
+        
+        void reserve(size_type n)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            parent_class::reserve(n);
+        }
+        
+        /**
+         Changes the size of the array, but unlike the resize(), the new bytes
+         are not initialized. Use this method when you're going to overwrite the
+         new bytes immediately, for example by a decoder. All new bytes must be
+         written, otherwise the array contains an unpredictable content.
+         */
+        void resizeUninitialized(size_type n)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
+            parent_class::resize(n);
+        }
+        
+        /**
+         Reserves capacity for |count| more bytes and returns reference
+         to this array. You can use the method as a reservation hint at
+         the beginning of the append chain, to avoid multiple reallocations:
+         
+            ByteArray(prefix).reserveForAppend(n1 + n2).append(r1).append(r2)
+         */
+        ByteArray & reserveForAppend(size_type count)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            parent_class::reserve(size() + count);
+            return *this;
+        }
+        
+        //
+        // Operations which may shrink the array. The watermark is updated
+        // before the size is reduced.
+        //
+        
+        void clear() noexcept
+        {
+            _updateWatermark();
+            parent_class::clear();
+        }
+        
+        void resize(size_type n)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
+            parent_class::resize(n, 0);
+        }
+        
+        void resize(size_type n, const value_type & val)
+        {
+            detail::GrowthObserver<ByteArray> observer(*this);
+            _updateWatermark();
+            parent_class::resize(n, val);
+        }
+        
+        void pop_back()
+        {
+            _updateWatermark();
+            parent_class::pop_back();
+        }
+        
+        iterator erase(const_iterator position)
+        {
+            _updateWatermark();
+            return parent_class::erase(position);
+        }
+        
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            _updateWatermark();
+            return parent_class::erase(first, last);
+        }
+        
+        void swap(ByteArray & other) noexcept
+        {
+            parent_class::swap(other);
+            std::swap(_watermark, other._watermark);
+        }
+        
         //
         // Other custom methods
         //
         
-        void secureClear()
+        /**
+         The WipeMode defines how many bytes are cleaned by the secureClear() method.
+         */
+        enum WipeMode
+        {
+            /**
+             Only bytes up to the highWatermark() are cleaned. All bytes behind
+             the watermark have never been written by the array's methods.
+             */
+            WipeWritten,
+            /**
+             Whole capacity is cleaned. Use this mode if you write to the array's
+             memory through the raw data() pointer, behind the current size.
+             */
+            WipeCapacity
+        };
+        
+        /**
+         Returns the highest size of the array, since its buffer was allocated,
+         or since the last secureClear(). The value is never greater than capacity().
+         */
+        size_type highWatermark() const noexcept
+        {
+            size_type watermark = _watermark > size() ? _watermark : size();
+            return watermark < capacity() ? watermark : capacity();
+        }
+        
+        /**
+         Securely cleans the content of the array and sets its size to zero.
+         The capacity is not changed, so the array can be reused.
+         */
+        void secureClear(WipeMode mode = WipeWritten)
         {
-            CC7_SecureClean(data(), capacity());
+            const size_type wipe_size = mode == WipeCapacity ? capacity() : highWatermark();
+            CC7_SecureClean(data(), wipe_size);
+            detail::AllocationStats_OnWipe(wipe_size, true);
             parent_class::clear();
+            _watermark = 0;
         }
         
         bool readFromBase64String(const std::string & base64_string, size_t wrap_size = 0);
@@ -140,6 +432,20 @@ namespace cc7
         
         std::string base64String(size_t wrap_size = 0) const;
         std::string hexString(bool lower_case = false) const;
+        
+    private:
+        
+        void _updateWatermark() noexcept
+        {
+            if (_watermark < size()) {
+                _watermark = size();
+            }
+        }
+        
+        /**
+         The highest size of the array, before the last shrinking operation.
+         */
+        size_type _watermark = 0;
     };
     
     /**
@@ -0,0 +1,305 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/SharedBytes.h>
+#include <deque>
+
+#if !defined(CC7_WINDOWS)
+#include <sys/uio.h>
+#endif
+
+namespace cc7
+{
+    //
+    // The ByteChain class is a sequence of byte segments, which together
+    // represents one logical message. Unlike the ByteArray, appending,
+    // prepending or splicing the data doesn't copy the bytes, only the
+    // list of segments is modified.
+    //
+    // Each segment is either owned, or borrowed:
+    //
+    //  - owned segments are kept in SharedBytes objects, so the chain shares
+    //    the ownership with other chains or SharedBytes instances. You can
+    //    also move ByteArray to the chain, which then becomes an owned segment.
+    //
+    //  - borrowed segments are just ByteRange objects. It's up to you to
+    //    guarantee that the referenced memory is valid while the chain uses it.
+    //
+    // The chain is not thread safe, but its owned segments can be safely
+    // shared between threads.
+    //
+
+    class ByteChain
+    {
+    public:
+
+        typedef size_t      size_type;
+
+        typedef cc7::detail::ExceptionsWrapper<ByteChain> _ByteChainExceptions;
+
+    private:
+
+        struct Segment
+        {
+            SharedBytes owner;
+            ByteRange   range;
+        };
+
+        typedef std::deque<Segment> SegmentList;
+
+    public:
+
+        /**
+         The const_iterator iterates over all segments in the chain.
+         Dereferenced iterator returns ByteRange with segment's data.
+         */
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag   iterator_category;
+            typedef ByteRange                   value_type;
+            typedef ptrdiff_t                   difference_type;
+            typedef const ByteRange*            pointer;
+            typedef const ByteRange&            reference;
+
+            const_iterator(SegmentList::const_iterator it) : _it(it)
+            {
+            }
+            reference operator*() const
+            {
+                return _it->range;
+            }
+            pointer operator->() const
+            {
+                return &_it->range;
+            }
+            const_iterator & operator++()
+            {
+                ++_it;
+                return *this;
+            }
+            const_iterator operator++(int)
+            {
+                const_iterator tmp(*this);
+                ++_it;
+                return tmp;
+            }
+            bool operator==(const const_iterator & other) const
+            {
+                return _it == other._it;
+            }
+            bool operator!=(const const_iterator & other) const
+            {
+                return _it != other._it;
+            }
+        private:
+            SegmentList::const_iterator _it;
+        };
+
+        // Construction
+
+        ByteChain() :
+            _size(0)
+        {
+        }
+
+        explicit ByteChain(ByteArray && array) :
+            _size(0)
+        {
+            append(std::move(array));
+        }
+
+        explicit ByteChain(const SharedBytes & bytes) :
+            _size(0)
+        {
+            append(bytes);
+        }
+
+        // Size & segments
+
+        /**
+         Returns total number of bytes in the chain.
+         */
+        size_type size() const
+        {
+            return _size;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        /**
+         Returns number of segments in the chain.
+         */
+        size_type segmentsCount() const
+        {
+            return _segments.size();
+        }
+
+        /**
+         Returns data of segment at given index.
+         */
+        ByteRange segment(size_type index) const
+        {
+            if (index < _segments.size()) {
+                return _segments[index].range;
+            }
+            return ByteRange::_ByteRangeExceptions::out_of_range();
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(_segments.begin());
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(_segments.end());
+        }
+
+        // Append
+
+        /**
+         Moves the array to the end of the chain, as an owned segment.
+         */
+        ByteChain & append(ByteArray && array);
+
+        /**
+         Appends owned segment to the end of the chain.
+         */
+        ByteChain & append(const SharedBytes & bytes);
+
+        /**
+         Appends all segments from other chain. The owned segments are shared
+         between both chains.
+         */
+        ByteChain & append(const ByteChain & chain);
+
+        /**
+         Appends borrowed segment to the end of the chain. The memory referenced
+         by the range must be valid while the chain is using it.
+         */
+        ByteChain & appendBorrowed(const ByteRange & range);
+
+        // Prepend
+
+        ByteChain & prepend(ByteArray && array);
+        ByteChain & prepend(const SharedBytes & bytes);
+        ByteChain & prepend(const ByteChain & chain);
+        ByteChain & prependBorrowed(const ByteRange & range);
+
+        // Splice & remove
+
+        /**
+         Inserts all segments from other chain at given byte |position|.
+         If the position points to the middle of segment, then the segment
+         is split into two, without copying the data.
+         */
+        ByteChain & splice(size_type position, const ByteChain & chain);
+
+        /**
+         Removes first |count| bytes from the chain. This is useful after the
+         partial write, when only part of the chain has been processed.
+         */
+        void removePrefix(size_type count);
+
+        /**
+         Removes last |count| bytes from the chain.
+         */
+        void removeSuffix(size_type count);
+
+        /**
+         Removes all segments from the chain.
+         */
+        void clear();
+
+        // Conversions
+
+        /**
+         Returns ByteArray with all bytes from the chain. The array is allocated
+         only once, and each segment is copied exactly once.
+         */
+        ByteArray flatten() const;
+
+        /**
+         Returns a new chain with |count| bytes, starting at |from| position.
+         The returned chain shares the owned segments with this chain.
+         */
+        ByteChain subChain(size_type from, size_type count) const;
+
+#if !defined(CC7_WINDOWS)
+        /**
+         Fills up to |max_count| iovec structures with segments, starting at
+         |first_segment| index. Returns number of filled structures. You can use
+         the result directly in writev() system call.
+
+         Note that the iovec structure has non-const pointer, but you must not
+         modify the referenced memory, because the segments may be shared with
+         other owners. Use prepareReceive() for the readv() system call.
+         */
+        size_type exportIOVec(struct iovec * iov, size_type max_count, size_type first_segment = 0) const;
+
+        /**
+         Returns vector of iovec structures, one for each segment. The vector is
+         suitable only for writev(). See exportIOVec() for details.
+         */
+        std::vector<struct iovec> ioVectors() const;
+
+        /**
+         Appends |count| new owned segments, each with |segment_size| bytes, and fills
+         |iov| with writable pointers to them. The content of the new segments is not
+         initialized. Returns number of prepared bytes. Use the result in readv()
+         system call, and then call commitReceive() with the actual number of bytes
+         received:
+
+            struct iovec iov[4];
+            size_t prepared = chain.prepareReceive(iov, 4, 4096);
+            ssize_t received = readv(fd, iov, 4);
+            chain.commitReceive(prepared, received > 0 ? received : 0);
+
+         You must not copy the chain, or share its segments, until the receive
+         is committed.
+         */
+        size_type prepareReceive(struct iovec * iov, size_type count, size_type segment_size);
+
+        /**
+         Finishes the receive started by prepareReceive(). The segments are trimmed
+         to |received| bytes, so the bytes which were not received are removed from
+         the end of the chain.
+         */
+        void commitReceive(size_type prepared_size, size_type received);
+#endif
+
+    private:
+
+        void _pushBack(const SharedBytes & owner, const ByteRange & range);
+        void _pushFront(const SharedBytes & owner, const ByteRange & range);
+
+        /**
+         Splits segment at byte |position| and returns index of the segment
+         which starts at the position.
+         */
+        size_type _splitAt(size_type position);
+
+        SegmentList _segments;
+        size_type   _size;
+    };
+
+} // cc7
@@ -20,6 +20,8 @@
 
 namespace cc7
 {   
+    class ByteRangeSplit;
+    
     class ByteRange
     {
     public:
@@ -309,13 +311,85 @@ namespace cc7
             return _ByteRangeExceptions::out_of_range();
         }
         
-        ByteRange subRange(size_type from, size_type count)
+        ByteRange subRange(size_type from, size_type count) const
         {
             if ((from <= size()) && (from + count <= size())) {
                 return ByteRange(begin() + from, count);
             }
             return _ByteRangeExceptions::out_of_range();
         }
+        
+        // Exception-free variants. Unlike the methods above, the following methods
+        // never throw, nor assert. They return false if the requested range is
+        // out of bounds and in this case, the range, or the output parameter
+        // is not changed.
+        
+        bool tryRemovePrefix(size_type count) noexcept
+        {
+            if (count <= size()) {
+                _begin += count;
+                return true;
+            }
+            return false;
+        }
+        
+        bool tryRemoveSuffix(size_type count) noexcept
+        {
+            if (count <= size()) {
+                _end -= count;
+                return true;
+            }
+            return false;
+        }
+        
+        /**
+         Removes first |count| bytes from the range and returns them in |out_prefix|.
+         */
+        bool tryPopPrefix(size_type count, ByteRange & out_prefix) noexcept
+        {
+            if (count <= size()) {
+                out_prefix.assign(_begin, count);
+                _begin += count;
+                return true;
+            }
+            return false;
+        }
+        
+        bool trySubRangeFrom(size_type from, ByteRange & out_range) const noexcept
+        {
+            if (from <= size()) {
+                out_range.assign(_begin + from, size() - from);
+                return true;
+            }
+            return false;
+        }
+        
+        bool trySubRangeTo(size_type to, ByteRange & out_range) const noexcept
+        {
+            if (to <= size()) {
+                out_range.assign(_begin, to);
+                return true;
+            }
+            return false;
+        }
+        
+        bool trySubRange(size_type from, size_type count, ByteRange & out_range) const noexcept
+        {
+            if ((from <= size()) && (count <= size() - from)) {
+                out_range.assign(_begin + from, count);
+                return true;
+            }
+            return false;
+        }
+        
+        bool tryAt(size_type index, value_type & out_value) const noexcept
+        {
+            if (index < size()) {
+                out_value = _begin[index];
+                return true;
+            }
+            return false;
+        }
             
         int compare(const ByteRange & other) const noexcept
         {
@@ -332,6 +406,70 @@ namespace cc7
             return res;
         }
         
+        /**
+         Returns true if this range has the same content as |other|. Unlike compare()
+         or the == operator, the time spent in comparison doesn't depend on the content,
+         so the method is suitable for checking MACs, authentication tags or tokens.
+         The length of the ranges is not considered secret, so the ranges with
+         different sizes are not equal and the method returns immediately.
+         */
+        bool equalsConstantTime(const ByteRange & other) const noexcept;
+        
+        // Searching. All methods return npos if the value is not found.
+        
+        /**
+         Returns position of the first occurrence of byte |b|, starting at |pos|.
+         */
+        size_type find(value_type b, size_type pos = 0) const noexcept
+        {
+            if (pos >= size()) {
+                return npos;
+            }
+            const void * found = memchr(_begin + pos, b, size() - pos);
+            return found ? static_cast<const_pointer>(found) - _begin : npos;
+        }
+        
+        /**
+         Returns position of the first occurrence of |needle|, starting at |pos|.
+         The empty needle is found at |pos|, if |pos| is not greater than size().
+         */
+        size_type find(const ByteRange & needle, size_type pos = 0) const noexcept;
+        
+        /**
+         Returns position of the last occurrence of byte |b|, which begins
+         at or before |pos|.
+         */
+        size_type rfind(value_type b, size_type pos = npos) const noexcept;
+        
+        /**
+         Returns position of the last occurrence of |needle|, which begins
+         at or before |pos|.
+         */
+        size_type rfind(const ByteRange & needle, size_type pos = npos) const noexcept;
+        
+        /**
+         Returns position of the first byte, which is equal to any byte from |set|,
+         starting at |pos|.
+         */
+        size_type find_first_of(const ByteRange & set, size_type pos = 0) const noexcept;
+        
+        bool startsWith(const ByteRange & prefix) const noexcept
+        {
+            return prefix.size() <= size() && (prefix.empty() || memcmp(_begin, prefix.data(), prefix.size()) == 0);
+        }
+        
+        bool endsWith(const ByteRange & suffix) const noexcept
+        {
+            return suffix.size() <= size() && (suffix.empty() || memcmp(_end - suffix.size(), suffix.data(), suffix.size()) == 0);
+        }
+        
+        /**
+         Returns a lazy sequence of sub-ranges, separated by the |delimiter|.
+         See ByteRangeSplit class for details.
+         */
+        ByteRangeSplit split(value_type delimiter) const noexcept;
+        ByteRangeSplit split(const ByteRange & delimiter) const noexcept;
+        
     protected:
             
         void _validateBeginEnd(const_pointer begin, const_pointer end)
@@ -343,6 +481,169 @@ namespace cc7
             
     };
         
+    //
+    // The ByteRangeSplit class is a lazy sequence of sub-ranges, separated by
+    // a delimiter. No memory is allocated, all produced ranges point to
+    // the original data. The sequence contains one range more than is the
+    // number of delimiters, so for example "a,,b," produces "a", "", "b"
+    // and "". The empty delimiter produces the whole range.
+    //
+    //      for (ByteRange line : data.split('\n')) {
+    //          ...
+    //      }
+    //
+    class ByteRangeSplit
+    {
+    public:
+        
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag   iterator_category;
+            typedef ByteRange                   value_type;
+            typedef ptrdiff_t                   difference_type;
+            typedef const ByteRange*            pointer;
+            typedef const ByteRange&            reference;
+            
+            const_iterator() noexcept :
+                _split(nullptr),
+                _next(0),
+                _at_end(true)
+            {
+            }
+            
+            reference operator*() const noexcept
+            {
+                return _current;
+            }
+            
+            pointer operator->() const noexcept
+            {
+                return &_current;
+            }
+            
+            const_iterator & operator++() noexcept
+            {
+                _advance();
+                return *this;
+            }
+            
+            const_iterator operator++(int) noexcept
+            {
+                const_iterator tmp = *this;
+                _advance();
+                return tmp;
+            }
+            
+            bool operator==(const const_iterator & other) const noexcept
+            {
+                if (_at_end || other._at_end) {
+                    return _at_end == other._at_end;
+                }
+                return _split == other._split && _current.data() == other._current.data() && _next == other._next;
+            }
+            
+            bool operator!=(const const_iterator & other) const noexcept
+            {
+                return !(*this == other);
+            }
+            
+        private:
+            
+            friend class ByteRangeSplit;
+            
+            explicit const_iterator(const ByteRangeSplit * split) noexcept :
+                _split(split),
+                _next(0),
+                _at_end(false)
+            {
+                _advance();
+            }
+            
+            void _advance() noexcept
+            {
+                const ByteRange & source = _split->_source;
+                if (_next == ByteRange::npos) {
+                    _at_end = true;
+                    return;
+                }
+                const size_t delimiter_size = _split->_delimiter.size();
+                const size_t found = delimiter_size == 1
+                                        ? source.find(_split->_delimiter[0], _next)
+                                        : (delimiter_size > 0 ? source.find(_split->_delimiter, _next) : ByteRange::npos);
+                if (found == ByteRange::npos) {
+                    _current = ByteRange(source.data() + _next, source.size() - _next);
+                    _next    = ByteRange::npos;
+                } else {
+                    _current = ByteRange(source.data() + _next, found - _next);
+                    _next    = found + delimiter_size;
+                }
+            }
+            
+            const ByteRangeSplit *  _split;
+            ByteRange               _current;
+            size_t                  _next;
+            bool                    _at_end;
+        };
+        
+        typedef const_iterator iterator;
+        
+        ByteRangeSplit(const ByteRange & source, const ByteRange & delimiter) noexcept :
+            _source(source),
+            _delimiter(delimiter)
+        {
+        }
+        
+        ByteRangeSplit(const ByteRange & source, cc7::byte delimiter) noexcept :
+            _source(source),
+            _delimiter_byte(delimiter)
+        {
+            _delimiter = ByteRange(&_delimiter_byte, 1);
+        }
+        
+        ByteRangeSplit(const ByteRangeSplit & other) noexcept :
+            _source(other._source),
+            _delimiter(other._delimiter),
+            _delimiter_byte(other._delimiter_byte)
+        {
+            if (other._delimiter.data() == &other._delimiter_byte) {
+                _delimiter = ByteRange(&_delimiter_byte, 1);
+            }
+        }
+        
+        ByteRangeSplit & operator=(const ByteRangeSplit &) = delete;
+        
+        /**
+         Returns iterator to the first sub-range. Note that the iterators point
+         to this object, so it must exist for the whole iteration.
+         */
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(this);
+        }
+        
+        const_iterator end() const noexcept
+        {
+            return const_iterator();
+        }
+        
+    private:
+        
+        ByteRange   _source;
+        ByteRange   _delimiter;
+        cc7::byte   _delimiter_byte = 0;
+    };
+    
+    inline ByteRangeSplit ByteRange::split(value_type delimiter) const noexcept
+    {
+        return ByteRangeSplit(*this, delimiter);
+    }
+    
+    inline ByteRangeSplit ByteRange::split(const ByteRange & delimiter) const noexcept
+    {
+        return ByteRangeSplit(*this, delimiter);
+    }
+    
     // ByteRange comparation operators
     
     inline bool operator==(const ByteRange & x, const ByteRange & y)
@@ -369,6 +670,13 @@ namespace cc7
     {
         return x.compare(y) <= 0;
     }
+    
+    /**
+     Returns true if |x| and |y| have the same content. The comparison time
+     doesn't depend on the content of the ranges, only on their length.
+     See ByteRange::equalsConstantTime() for details.
+     */
+    bool EqualsConstantTime(const ByteRange & x, const ByteRange & y) noexcept;
         
     /**
      Copy conversion from ByteRange to the std::string object.
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteRange.h>
+#include <vector>
+
+namespace cc7
+{
+    //
+    // Sorting of large arrays of ByteRange objects. The result is the same
+    // as for std::sort() with the ByteRange's < operator (lexicographical
+    // order, where a shorter prefix goes first), but the sort doesn't call
+    // memcmp() for each comparison.
+    //
+    // The implementation is a MSD radix sort over 8 byte key prefixes, which
+    // are loaded once per each level and cached next to the range, so the
+    // most of the work is done on a sequential memory. Only the keys which
+    // share the same 8 byte prefix are processed on the next level. The sort
+    // requires additional memory, about three times the size of the sorted
+    // array.
+    //
+
+    /**
+     Sorts |count| ranges in the |ranges| array. If the |threads_count| is
+     greater than 1, then the work is split to multiple threads. The value 0
+     means that the number of threads is determined by the hardware.
+     */
+    void SortByteRanges(ByteRange * ranges, size_t count, size_t threads_count = 1);
+
+    inline void SortByteRanges(std::vector<ByteRange> & ranges, size_t threads_count = 1)
+    {
+        SortByteRanges(ranges.data(), ranges.size(), threads_count);
+    }
+
+    /**
+     Removes consecutive ranges with the same content from the sorted array,
+     like std::unique(). Returns the number of unique ranges, which are moved
+     to the beginning of the array.
+     */
+    size_t UniqueByteRanges(ByteRange * ranges, size_t count);
+
+    /**
+     Sorts the vector and removes all duplicates.
+     */
+    inline void SortAndUniqueByteRanges(std::vector<ByteRange> & ranges, size_t threads_count = 1)
+    {
+        SortByteRanges(ranges.data(), ranges.size(), threads_count);
+        ranges.resize(UniqueByteRanges(ranges.data(), ranges.size()));
+    }
+
+} // cc7
@@ -0,0 +1,337 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteRange.h>
+#include <cc7/Endian.h>
+#include <cc7/Varint.h>
+
+namespace cc7
+{
+    //
+    // The ByteReader class reads binary encoded data from the ByteRange.
+    // All read methods return false if there's not enough data available.
+    // In this case, the reader's position is not changed. The byte sequences
+    // are returned as ByteRange objects, pointing to the original data, so
+    // no copy is made.
+    //
+    // If your structure has a fixed size, then you can use the block() method,
+    // which checks the available data once and returns a Block object with
+    // no bounds checking at all:
+    //
+    //      ByteReader reader(frame);
+    //      ByteReader::Block header;
+    //      ByteRange payload;
+    //      if (!reader.block(7, header)) {
+    //          return false;
+    //      }
+    //      U8  type   = header.getByte();
+    //      U16 msg_id = header.getBigEndian<U16>();
+    //      U32 length = header.getBigEndian<U32>();
+    //      if (!reader.readBytes(length, payload)) {
+    //          return false;
+    //      }
+    //
+
+    class ByteReader
+    {
+    public:
+
+        /**
+         The Block is a fixed size window to the source range, which has been
+         acquired by the ByteReader::block() method. The Block doesn't check
+         bounds, except the CC7_ASSERT in debug builds.
+         */
+        class Block
+        {
+        public:
+
+            Block() :
+                _p(nullptr),
+                _end(nullptr)
+            {
+            }
+
+            cc7::byte getByte()
+            {
+                CC7_ASSERT(_p + 1 <= _end, "ByteReader::Block: Out of range");
+                return *_p++;
+            }
+
+            template <typename T> T getBigEndian()
+            {
+                CC7_ASSERT(_p + sizeof(T) <= _end, "ByteReader::Block: Out of range");
+                T value = LoadBigEndian<T>(_p);
+                _p += sizeof(T);
+                return value;
+            }
+
+            template <typename T> T getLittleEndian()
+            {
+                CC7_ASSERT(_p + sizeof(T) <= _end, "ByteReader::Block: Out of range");
+                T value = LoadLittleEndian<T>(_p);
+                _p += sizeof(T);
+                return value;
+            }
+
+            ByteRange getBytes(size_t count)
+            {
+                CC7_ASSERT(_p + count <= _end, "ByteReader::Block: Out of range");
+                ByteRange range(_p, count);
+                _p += count;
+                return range;
+            }
+
+            /**
+             Returns number of bytes which can still be read from the block.
+             */
+            size_t remaining() const
+            {
+                return _end - _p;
+            }
+
+        private:
+
+            friend class ByteReader;
+
+            Block(const cc7::byte * p, size_t size) :
+                _p(p),
+                _end(p + size)
+            {
+            }
+
+            const cc7::byte * _p;
+            const cc7::byte * _end;
+        };
+
+        /**
+         Constructs a reader for given range. The range must be valid
+         for the whole reader's lifetime.
+         */
+        explicit ByteReader(const ByteRange & range) :
+            _begin(range.data()),
+            _p(range.data()),
+            _end(range.data() + range.size())
+        {
+        }
+
+        // Status
+
+        /**
+         Returns number of already processed bytes.
+         */
+        size_t offset() const
+        {
+            return _p - _begin;
+        }
+
+        /**
+         Returns number of bytes available for reading.
+         */
+        size_t remaining() const
+        {
+            return _end - _p;
+        }
+
+        bool atEnd() const
+        {
+            return _p == _end;
+        }
+
+        /**
+         Returns range with all bytes available for reading.
+         */
+        ByteRange remainingRange() const
+        {
+            return ByteRange(_p, _end);
+        }
+
+        // Blocks
+
+        /**
+         Acquires next |count| bytes as a Block. Returns false if there's not
+         enough data available.
+         */
+        bool block(size_t count, Block & out_block)
+        {
+            if (count > remaining()) {
+                return false;
+            }
+            out_block = Block(_p, count);
+            _p += count;
+            return true;
+        }
+
+        bool skip(size_t count)
+        {
+            if (count > remaining()) {
+                return false;
+            }
+            _p += count;
+            return true;
+        }
+
+        // Integers
+
+        bool readByte(cc7::byte & out_value)
+        {
+            if (_p == _end) {
+                return false;
+            }
+            out_value = *_p++;
+            return true;
+        }
+
+        template <typename T> bool readBigEndian(T & out_value)
+        {
+            if (sizeof(T) > remaining()) {
+                return false;
+            }
+            out_value = LoadBigEndian<T>(_p);
+            _p += sizeof(T);
+            return true;
+        }
+
+        template <typename T> bool readLittleEndian(T & out_value)
+        {
+            if (sizeof(T) > remaining()) {
+                return false;
+            }
+            out_value = LoadLittleEndian<T>(_p);
+            _p += sizeof(T);
+            return true;
+        }
+
+        bool readU16(U16 & out_value)   { return readBigEndian<U16>(out_value); }
+        bool readU32(U32 & out_value)   { return readBigEndian<U32>(out_value); }
+        bool readU64(U64 & out_value)   { return readBigEndian<U64>(out_value); }
+        bool readU16LE(U16 & out_value) { return readLittleEndian<U16>(out_value); }
+        bool readU32LE(U32 & out_value) { return readLittleEndian<U32>(out_value); }
+        bool readU64LE(U64 & out_value) { return readLittleEndian<U64>(out_value); }
+
+        /**
+         Reads variable length integer (LEB128 varint). Returns false if the varint
+         is incomplete, or if it doesn't fit to the output type.
+         */
+        template <typename T> bool readVarint(T & out_value)
+        {
+            size_t size;
+            if (!Varint_Decode(remainingRange(), out_value, size)) {
+                return false;
+            }
+            _p += size;
+            return true;
+        }
+
+        // Bulk
+
+        /**
+         Reads |count| big endian integers to |out_values| array. The bounds are
+         checked only once, for the whole array.
+         */
+        template <typename T> bool readBigEndian(T * out_values, size_t count)
+        {
+            if (count > remaining() / sizeof(T)) {
+                return false;
+            }
+            for (size_t i = 0; i < count; i++) {
+                out_values[i] = LoadBigEndian<T>(_p);
+                _p += sizeof(T);
+            }
+            return true;
+        }
+
+        /**
+         Reads |count| little endian integers to |out_values| array. The bounds are
+         checked only once, for the whole array.
+         */
+        template <typename T> bool readLittleEndian(T * out_values, size_t count)
+        {
+            if (count > remaining() / sizeof(T)) {
+                return false;
+            }
+        #if defined(CC7_LITTLE_ENDIAN)
+            memcpy(out_values, _p, count * sizeof(T));
+            _p += count * sizeof(T);
+        #else
+            for (size_t i = 0; i < count; i++) {
+                out_values[i] = LoadLittleEndian<T>(_p);
+                _p += sizeof(T);
+            }
+        #endif
+            return true;
+        }
+
+        /**
+         Reads |count| varints to |out_values| array. If there's not enough varints,
+         or some of them is malformed, then returns false and the position is not changed.
+         */
+        template <typename T> bool readVarints(T * out_values, size_t count)
+        {
+            size_t consumed;
+            if (Varint_DecodeArray(remainingRange(), out_values, count, consumed) != count) {
+                return false;
+            }
+            _p += consumed;
+            return true;
+        }
+
+        // Bytes
+
+        /**
+         Returns next |count| bytes in |out_range|. The range points to the
+         reader's source data.
+         */
+        bool readBytes(size_t count, ByteRange & out_range)
+        {
+            if (count > remaining()) {
+                return false;
+            }
+            out_range = ByteRange(_p, count);
+            _p += count;
+            return true;
+        }
+
+        /**
+         Reads big endian length of LengthType, followed by the sequence of bytes,
+         which is returned in |out_range|. The range points to the reader's source
+         data. If the sequence is not complete, then returns false and the position
+         is not changed.
+         */
+        template <typename LengthType> bool readLengthPrefixed(ByteRange & out_range)
+        {
+            if (sizeof(LengthType) > remaining()) {
+                return false;
+            }
+            const U64 length = LoadBigEndian<LengthType>(_p);
+            if (length > remaining() - sizeof(LengthType)) {
+                return false;
+            }
+            _p += sizeof(LengthType);
+            out_range = ByteRange(_p, static_cast<size_t>(length));
+            _p += static_cast<size_t>(length);
+            return true;
+        }
+
+    private:
+
+        const cc7::byte * _begin;
+        const cc7::byte * _p;
+        const cc7::byte * _end;
+    };
+
+} // cc7
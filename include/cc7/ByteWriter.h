@@ -0,0 +1,326 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+#include <cc7/Endian.h>
+#include <cc7/Varint.h>
+#include <limits>
+
+namespace cc7
+{
+    //
+    // The ByteWriter class appends binary encoded data to the ByteArray.
+    // Unlike the sequence of ByteArray::append() calls, the writer grows the
+    // target array in larger steps and writes the integers directly to the
+    // array's memory, in requested byte order.
+    //
+    // If you know the size of the data in advance, then you can use block()
+    // method, which checks the available space once and returns a Block
+    // object with no bounds checking at all:
+    //
+    //      ByteArray frame;
+    //      {
+    //          ByteWriter writer(frame);
+    //          writer.block(7)
+    //              .putByte(0x01)
+    //              .putBigEndian<U16>(msg_id)
+    //              .putBigEndian<U32>(payload.size());
+    //          writer.writeBytes(payload);
+    //      }
+    //      // frame is complete here
+    //
+    // While the writer is active, the target array may contain a reserved space
+    // behind the written data. The array is trimmed to the actual size in
+    // finish() method, or when the writer is destroyed.
+    //
+
+    class ByteWriter
+    {
+    public:
+
+        /**
+         The Block is a fixed size window to the target array, which has been
+         reserved by the ByteWriter::block() method. The Block doesn't check
+         bounds, except the CC7_ASSERT in debug builds.
+         */
+        class Block
+        {
+        public:
+
+            Block & putByte(cc7::byte value)
+            {
+                CC7_ASSERT(_p + 1 <= _end, "ByteWriter::Block: Out of range");
+                *_p++ = value;
+                return *this;
+            }
+
+            template <typename T> Block & putBigEndian(T value)
+            {
+                CC7_ASSERT(_p + sizeof(T) <= _end, "ByteWriter::Block: Out of range");
+                StoreBigEndian<T>(_p, value);
+                _p += sizeof(T);
+                return *this;
+            }
+
+            template <typename T> Block & putLittleEndian(T value)
+            {
+                CC7_ASSERT(_p + sizeof(T) <= _end, "ByteWriter::Block: Out of range");
+                StoreLittleEndian<T>(_p, value);
+                _p += sizeof(T);
+                return *this;
+            }
+
+            Block & putBytes(const ByteRange & range)
+            {
+                CC7_ASSERT(_p + range.size() <= _end, "ByteWriter::Block: Out of range");
+                if (!range.empty()) {
+                    memcpy(_p, range.data(), range.size());
+                    _p += range.size();
+                }
+                return *this;
+            }
+
+            /**
+             Returns number of bytes which can still be written to the block.
+             */
+            size_t remaining() const
+            {
+                return _end - _p;
+            }
+
+        private:
+
+            friend class ByteWriter;
+
+            Block(cc7::byte * p, size_t size) :
+                _p(p),
+                _end(p + size)
+            {
+            }
+
+            cc7::byte * _p;
+            cc7::byte * _end;
+        };
+
+        /**
+         Constructs a writer, which appends data to the |target| array. The |reserve_size|
+         is a hint for how many bytes will be written.
+         */
+        explicit ByteWriter(ByteArray & target, size_t reserve_size = 0) :
+            _target(target),
+            _start(target.size()),
+            _pos(target.size())
+        {
+            if (reserve_size > 0) {
+                reserve(reserve_size);
+            }
+        }
+
+        ~ByteWriter()
+        {
+            finish();
+        }
+
+        ByteWriter(const ByteWriter &) = delete;
+        ByteWriter & operator=(const ByteWriter &) = delete;
+
+        /**
+         Makes sure that at least |count| bytes can be written without growing
+         the target array.
+         */
+        ByteWriter & reserve(size_t count)
+        {
+            if (count > _target.size() - _pos) {
+                _grow(count);
+            }
+            return *this;
+        }
+
+        /**
+         Reserves |count| bytes and returns Block, which allows you to write
+         the reserved bytes with no further bounds checking. The block must be
+         completely filled, because the reserved bytes are not initialized.
+         */
+        Block block(size_t count)
+        {
+            reserve(count);
+            Block b(_target.data() + _pos, count);
+            _pos += count;
+            return b;
+        }
+
+        // Integers
+
+        ByteWriter & writeByte(cc7::byte value)
+        {
+            reserve(1);
+            _target[_pos++] = value;
+            return *this;
+        }
+
+        template <typename T> ByteWriter & writeBigEndian(T value)
+        {
+            block(sizeof(T)).putBigEndian<T>(value);
+            return *this;
+        }
+
+        template <typename T> ByteWriter & writeLittleEndian(T value)
+        {
+            block(sizeof(T)).putLittleEndian<T>(value);
+            return *this;
+        }
+
+        ByteWriter & writeU16(U16 value)    { return writeBigEndian<U16>(value); }
+        ByteWriter & writeU32(U32 value)    { return writeBigEndian<U32>(value); }
+        ByteWriter & writeU64(U64 value)    { return writeBigEndian<U64>(value); }
+        ByteWriter & writeU16LE(U16 value)  { return writeLittleEndian<U16>(value); }
+        ByteWriter & writeU32LE(U32 value)  { return writeLittleEndian<U32>(value); }
+        ByteWriter & writeU64LE(U64 value)  { return writeLittleEndian<U64>(value); }
+
+        /**
+         Writes |value| as a variable length integer (LEB128 varint).
+         */
+        ByteWriter & writeVarint(U64 value)
+        {
+            reserve(VARINT_MAX_SIZE_U64);
+            _pos += Varint_Encode(value, _target.data() + _pos);
+            return *this;
+        }
+
+        // Bulk
+
+        /**
+         Writes |count| integers from |values| array, in big endian order.
+         The bounds are checked only once, for the whole array.
+         */
+        template <typename T> ByteWriter & writeBigEndian(const T * values, size_t count)
+        {
+            values = _reserveFor(count * sizeof(T), values, count);
+            Block b = block(count * sizeof(T));
+            for (size_t i = 0; i < count; i++) {
+                b.putBigEndian<T>(values[i]);
+            }
+            return *this;
+        }
+
+        /**
+         Writes |count| integers from |values| array, in little endian order.
+         The bounds are checked only once, for the whole array.
+         */
+        template <typename T> ByteWriter & writeLittleEndian(const T * values, size_t count)
+        {
+            values = _reserveFor(count * sizeof(T), values, count);
+            Block b = block(count * sizeof(T));
+        #if defined(CC7_LITTLE_ENDIAN)
+            b.putBytes(ByteRange(values, count * sizeof(T)));
+        #else
+            for (size_t i = 0; i < count; i++) {
+                b.putLittleEndian<T>(values[i]);
+            }
+        #endif
+            return *this;
+        }
+
+        // Bytes
+
+        ByteWriter & writeBytes(const ByteRange & range)
+        {
+            const cc7::byte * source = _reserveFor(range.size(), range.data(), range.size());
+            block(range.size()).putBytes(ByteRange(source, range.size()));
+            return *this;
+        }
+
+        /**
+         Writes length of the range, encoded as big endian LengthType integer, followed
+         by the range's bytes. If the length cannot be encoded to LengthType, then
+         the length_error exception is thrown (or assert in case that exceptions are
+         disabled) and nothing is written.
+         */
+        template <typename LengthType> ByteWriter & writeLengthPrefixed(const ByteRange & range)
+        {
+            if (range.size() > std::numeric_limits<LengthType>::max()) {
+                detail::ExceptionsWrapper<cc7::byte>::length_error();
+                return *this;
+            }
+            const cc7::byte * source = _reserveFor(sizeof(LengthType) + range.size(), range.data(), range.size());
+            block(sizeof(LengthType) + range.size())
+                .putBigEndian<LengthType>(static_cast<LengthType>(range.size()))
+                .putBytes(ByteRange(source, range.size()));
+            return *this;
+        }
+
+        // Status
+
+        /**
+         Returns number of bytes written by this writer.
+         */
+        size_t size() const
+        {
+            return _pos - _start;
+        }
+
+        /**
+         Trims the target array to the actually written data. You can continue
+         with writing after this call.
+         */
+        void finish()
+        {
+            if (_target.size() != _pos) {
+                _target.resize(_pos);
+            }
+        }
+
+    private:
+
+        /**
+         Reserves |count| bytes for writing |source_count| elements from |source|.
+         The source may point to the target array, which may move while it grows,
+         so the returned pointer points to the same elements after the growth.
+         */
+        template <typename T> const T * _reserveFor(size_t count, const T * source, size_t source_count)
+        {
+            const cc7::byte * p = reinterpret_cast<const cc7::byte*>(source);
+            const cc7::byte * base = _target.data();
+            const bool aliased = source_count > 0 && p >= base && p < base + _target.size();
+            const size_t offset = aliased ? p - base : 0;
+            reserve(count);
+            if (aliased) {
+                return reinterpret_cast<const T*>(_target.data() + offset);
+            }
+            return source;
+        }
+
+        void _grow(size_t count)
+        {
+            // Grow at least by already written size, to keep appending amortized.
+            size_t step = size();
+            if (step < 64) {
+                step = 64;
+            }
+            if (step < count) {
+                step = count;
+            }
+            _target.resizeUninitialized(_pos + step);
+        }
+
+        ByteArray & _target;
+        size_t      _start;
+        size_t      _pos;
+    };
+
+} // cc7
@@ -18,8 +18,27 @@
 
 #include <cc7/Platform.h>
 #include <cc7/DebugFeatures.h>
+#include <cc7/AllocationStats.h>
 #include <cc7/Endian.h>
 #include <cc7/ByteArray.h>
+#include <cc7/SecureSmallByteArray.h>
+#include <cc7/AlignedByteArray.h>
+#include <cc7/LargeByteArray.h>
+#include <cc7/SecurePagePool.h>
+#include <cc7/RecyclingPool.h>
+#include <cc7/WipeQuarantine.h>
+#include <cc7/SharedBytes.h>
+#include <cc7/MutableByteRange.h>
+#include <cc7/ByteRangeSort.h>
+#include <cc7/OwnedBytes.h>
+#include <cc7/ByteChain.h>
+#include <cc7/MappedFile.h>
+#include <cc7/Varint.h>
+#include <cc7/ByteWriter.h>
+#include <cc7/ByteReader.h>
+#include <cc7/Hash.h>
+#include <cc7/Checksum.h>
+#include <cc7/DerReader.h>
 #include <cc7/Utilities.h>
 #include <cc7/Base32.h>
 #include <cc7/Base64.h>
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteRange.h>
+
+namespace cc7
+{
+    class ByteChain;
+
+    //
+    // Checksums for the data integrity checks. The functions are not
+    // suitable for protection against intentional modification of data.
+    //
+    //  - CRC32 is compatible with zlib, PNG, ZIP or Ethernet (polynomial 0x04C11DB7)
+    //  - CRC32C is the Castagnoli variant, used in iSCSI, SCTP or ext4 (0x1EDC6F41)
+    //  - Adler32 is compatible with zlib
+    //
+    // The CRC functions use the SSE4.2, PCLMULQDQ or ARMv8 CRC instructions,
+    // when available on the running CPU. Otherwise the slicing-by-8 table
+    // implementation is used.
+    //
+    // All functions support the incremental calculation. The value returned
+    // from the Update function is the checksum of all data processed so far,
+    // so you can pass it to the next Update call:
+    //
+    //      U32 crc = CRC32_Calculate(part1);
+    //      crc = CRC32_Update(crc, part2);
+    //
+    // The Combine functions calculate the checksum of two concatenated blocks
+    // from their checksums and the length of the second block. So the blocks
+    // can be processed in parallel.
+    //
+
+    /**
+     Returns CRC32 of |data|.
+     */
+    U32 CRC32_Calculate(const ByteRange & data);
+    U32 CRC32_Calculate(const ByteChain & data);
+
+    /**
+     Updates |crc|, calculated for the previous data, with the next |data|.
+     */
+    U32 CRC32_Update(U32 crc, const ByteRange & data);
+    U32 CRC32_Update(U32 crc, const ByteChain & data);
+
+    /**
+     Returns CRC32 of concatenated blocks A and B, where |crc_a| is CRC32 of
+     the block A, |crc_b| of block B and |length_b| is length of block B.
+     */
+    U32 CRC32_Combine(U32 crc_a, U32 crc_b, U64 length_b);
+
+    /**
+     Returns CRC32C of |data|.
+     */
+    U32 CRC32C_Calculate(const ByteRange & data);
+    U32 CRC32C_Calculate(const ByteChain & data);
+
+    /**
+     Updates |crc|, calculated for the previous data, with the next |data|.
+     */
+    U32 CRC32C_Update(U32 crc, const ByteRange & data);
+    U32 CRC32C_Update(U32 crc, const ByteChain & data);
+
+    /**
+     Returns CRC32C of concatenated blocks A and B. See CRC32_Combine() for details.
+     */
+    U32 CRC32C_Combine(U32 crc_a, U32 crc_b, U64 length_b);
+
+    /**
+     Returns Adler32 of |data|.
+     */
+    U32 Adler32_Calculate(const ByteRange & data);
+    U32 Adler32_Calculate(const ByteChain & data);
+
+    /**
+     Updates |adler|, calculated for the previous data, with the next |data|.
+     Note that Adler32 of empty data is 1.
+     */
+    U32 Adler32_Update(U32 adler, const ByteRange & data);
+    U32 Adler32_Update(U32 adler, const ByteChain & data);
+
+    /**
+     Returns Adler32 of concatenated blocks A and B. See CRC32_Combine() for details.
+     */
+    U32 Adler32_Combine(U32 adler_a, U32 adler_b, U64 length_b);
+
+namespace detail
+{
+    /**
+     Forces the CRC functions to use the slicing-by-8 table implementation,
+     even if the running CPU supports the accelerated one. Both implementations
+     produce the same results, so the function is intended only for the unit
+     testing of the table implementation.
+     */
+    void Checksum_ForceTableImplementation(bool force);
+
+} // cc7::detail
+} // cc7
@@ -0,0 +1,289 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteRange.h>
+
+namespace cc7
+{
+    //
+    // Identifiers of the most common universal ASN.1 types. The identifier
+    // is the first byte of the DER encoded element, so it includes the
+    // tag's class and the constructed bit.
+    //
+    const cc7::byte DER_BOOLEAN             = 0x01;
+    const cc7::byte DER_INTEGER             = 0x02;
+    const cc7::byte DER_BIT_STRING          = 0x03;
+    const cc7::byte DER_OCTET_STRING        = 0x04;
+    const cc7::byte DER_NULL                = 0x05;
+    const cc7::byte DER_OBJECT_IDENTIFIER   = 0x06;
+    const cc7::byte DER_UTF8_STRING         = 0x0C;
+    const cc7::byte DER_PRINTABLE_STRING    = 0x13;
+    const cc7::byte DER_IA5_STRING          = 0x16;
+    const cc7::byte DER_UTC_TIME            = 0x17;
+    const cc7::byte DER_GENERALIZED_TIME    = 0x18;
+    const cc7::byte DER_SEQUENCE            = 0x30;
+    const cc7::byte DER_SET                 = 0x31;
+
+    /**
+     Returns identifier of the context-specific tag with |number|, which must be
+     lower than 31. For example, the "[0] EXPLICIT" tag in X.509 certificate's
+     version is DER_ContextTag(0, true).
+     */
+    inline cc7::byte DER_ContextTag(cc7::byte number, bool constructed)
+    {
+        return 0x80 | (constructed ? 0x20 : 0x00) | (number & 0x1F);
+    }
+
+    /**
+     The DerElement describes one DER encoded element (tag, length and value).
+     All ranges point to the data which has been parsed.
+     */
+    struct DerElement
+    {
+        enum TagClass
+        {
+            Universal       = 0,
+            Application     = 1,
+            ContextSpecific = 2,
+            Private         = 3,
+        };
+
+        /// Class of the tag.
+        TagClass    tag_class;
+        /// true if the element contains nested elements.
+        bool        constructed;
+        /// Number of the tag, in the tag's class.
+        U32         tag_number;
+        /// Element's content.
+        ByteRange   value;
+        /// Whole element, including the tag and the length.
+        ByteRange   encoded;
+
+        DerElement() :
+            tag_class(Universal),
+            constructed(false),
+            tag_number(0)
+        {
+        }
+
+        /**
+         Returns true if element's identifier is equal to |identifier|. The method
+         works only for identifiers with the tag number lower than 31, which fits
+         to one byte.
+         */
+        bool hasIdentifier(cc7::byte identifier) const
+        {
+            return tag_number < 31 && identifier == ((tag_class << 6) | (constructed ? 0x20 : 0x00) | tag_number);
+        }
+    };
+
+    //
+    // The DerReader is a cursor-style reader of ASN.1 DER encoded data.
+    // The reader never allocates memory and never copies the data. All
+    // parsed values are returned as ByteRange objects, pointing to the
+    // source data, which must outlive the reader.
+    //
+    // The encoding is checked strictly, so the reader rejects the BER only
+    // features, like the indefinite length, or the non-minimal encoding
+    // of lengths, tags and integers. All read methods return false if
+    // the next element is malformed, or doesn't have the expected type.
+    // In this case, the reader's position is not changed.
+    //
+    // The nested elements are processed lazily, with a new reader:
+    //
+    //      DerReader cert_reader(certificate_data);
+    //      DerReader cert, tbs;
+    //      if (!cert_reader.readSequence(cert) || !cert.readSequence(tbs)) {
+    //          return false;
+    //      }
+    //      tbs.skipIf(DER_ContextTag(0, true));    // version is optional
+    //      ByteRange serial;
+    //      if (!tbs.readIntegerBytes(serial)) {
+    //          return false;
+    //      }
+    //
+
+    class DerReader
+    {
+    public:
+
+        DerReader() :
+            _begin(nullptr),
+            _p(nullptr),
+            _end(nullptr)
+        {
+        }
+
+        /**
+         Constructs a reader for given range. The range must be valid
+         for the whole reader's lifetime.
+         */
+        explicit DerReader(const ByteRange & range) :
+            _begin(range.data()),
+            _p(range.data()),
+            _end(range.data() + range.size())
+        {
+        }
+
+        // Status
+
+        /**
+         Returns number of already processed bytes.
+         */
+        size_t offset() const
+        {
+            return _p - _begin;
+        }
+
+        /**
+         Returns number of bytes available for reading.
+         */
+        size_t remaining() const
+        {
+            return _end - _p;
+        }
+
+        /**
+         Returns true if all elements have been processed. You should check
+         this after the last expected element, to reject trailing data.
+         */
+        bool atEnd() const
+        {
+            return _p == _end;
+        }
+
+        /**
+         Returns range with all bytes available for reading.
+         */
+        ByteRange remainingRange() const
+        {
+            return ByteRange(_p, _end);
+        }
+
+        // Generic elements
+
+        /**
+         Parses next element to |out_element|, without changing the reader's position.
+         */
+        bool peek(DerElement & out_element) const;
+
+        /**
+         Returns true if the next element has |identifier|.
+         */
+        bool nextHasIdentifier(cc7::byte identifier) const
+        {
+            DerElement element;
+            return peek(element) && element.hasIdentifier(identifier);
+        }
+
+        /**
+         Reads next element, with any tag.
+         */
+        bool read(DerElement & out_element);
+
+        /**
+         Reads next element, which must have |identifier|.
+         */
+        bool read(cc7::byte identifier, DerElement & out_element);
+
+        /**
+         Reads value of the next element, which must have |identifier|.
+         */
+        bool readValue(cc7::byte identifier, ByteRange & out_value);
+
+        /**
+         Skips next element, with any tag.
+         */
+        bool skip();
+
+        /**
+         Skips next element, if it has |identifier|. Returns true if the element
+         has been skipped. This is useful for optional or defaulted fields.
+         */
+        bool skipIf(cc7::byte identifier);
+
+        // Constructed elements
+
+        /**
+         Reads next constructed element with |identifier| and returns a reader
+         for its content in |out_reader|.
+         */
+        bool enter(cc7::byte identifier, DerReader & out_reader);
+
+        bool readSequence(DerReader & out_reader)
+        {
+            return enter(DER_SEQUENCE, out_reader);
+        }
+
+        bool readSet(DerReader & out_reader)
+        {
+            return enter(DER_SET, out_reader);
+        }
+
+        // Primitive types
+
+        /**
+         Reads INTEGER and returns its content, in two's complement, big endian
+         byte order. The content must be minimally encoded.
+         */
+        bool readIntegerBytes(ByteRange & out_value);
+
+        /**
+         Reads non-negative INTEGER, which fits to U64.
+         */
+        bool readInteger(U64 & out_value);
+
+        /**
+         Reads BOOLEAN. DER allows only 0x00 and 0xFF values.
+         */
+        bool readBoolean(bool & out_value);
+
+        /**
+         Reads NULL element.
+         */
+        bool readNull();
+
+        /**
+         Reads OBJECT IDENTIFIER and returns its encoded content. You can
+         compare the content with the expected, already encoded OID.
+         */
+        bool readObjectIdentifier(ByteRange & out_oid);
+
+        /**
+         Reads OCTET STRING.
+         */
+        bool readOctetString(ByteRange & out_value)
+        {
+            return readValue(DER_OCTET_STRING, out_value);
+        }
+
+        /**
+         Reads BIT STRING. The |out_bits| contains bytes with the bits and
+         |out_unused_bits| is the number of unused bits in the last byte.
+         The unused bits must be zero.
+         */
+        bool readBitString(ByteRange & out_bits, cc7::byte & out_unused_bits);
+
+    private:
+
+        const cc7::byte * _begin;
+        const cc7::byte * _p;
+        const cc7::byte * _end;
+    };
+
+} // cc7
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cc7/Platform.h>
+#include <string.h>
 
 // Check for clang builtin byte swap functions
 #if defined(__clang__) && __has_builtin(__builtin_bswap16) \
@@ -34,6 +35,11 @@ namespace cc7
     //
     namespace detail
     {
+        inline cc7::U8 SwapEndian(cc7::U8 n)
+        {
+            return n;
+        }
+        
         inline cc7::U16 SwapEndian(cc7::U16 n)
         {
         #ifdef CC7_BSWAP_16
@@ -118,4 +124,50 @@ namespace cc7
     #error "Wrong ENDIAN setup in cc7/Platform.h"
 #endif
     
+    //
+    // Unaligned memory access
+    //
+    
+    /**
+     Loads integer of type T from memory at |p|, which contains big endian representation.
+     The pointer doesn't need to be aligned.
+     */
+    template <typename T> inline T LoadBigEndian(const cc7::byte * p)
+    {
+        T n;
+        memcpy(&n, p, sizeof(T));
+        return FromBigEndian(n);
+    }
+    
+    /**
+     Loads integer of type T from memory at |p|, which contains little endian representation.
+     The pointer doesn't need to be aligned.
+     */
+    template <typename T> inline T LoadLittleEndian(const cc7::byte * p)
+    {
+        T n;
+        memcpy(&n, p, sizeof(T));
+        return FromLittleEndian(n);
+    }
+    
+    /**
+     Stores big endian representation of integer |n| to memory at |p|.
+     The pointer doesn't need to be aligned.
+     */
+    template <typename T> inline void StoreBigEndian(cc7::byte * p, T n)
+    {
+        n = ToBigEndian(n);
+        memcpy(p, &n, sizeof(T));
+    }
+    
+    /**
+     Stores little endian representation of integer |n| to memory at |p|.
+     The pointer doesn't need to be aligned.
+     */
+    template <typename T> inline void StoreLittleEndian(cc7::byte * p, T n)
+    {
+        n = ToLittleEndian(n);
+        memcpy(p, &n, sizeof(T));
+    }
+    
 } // cc7
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+#include <functional>
+
+namespace cc7
+{
+    //
+    // Fast, non-cryptographic 64-bit hash for byte sequences. The function
+    // is based on the wyhash algorithm and is designed for hash tables,
+    // not for the integrity protection or for the keyed authentication.
+    //
+    // If the hashed keys are controlled by an attacker, then you should
+    // use a secret, randomly generated seed, to make the hash flooding
+    // attacks harder.
+    //
+
+    /**
+     Returns 64-bit hash of |data|, calculated with given |seed|.
+     */
+    U64 Hash64(const ByteRange & data, U64 seed = 0);
+
+    /**
+     The ByteRangeHash is a hash function object for ByteRange, ByteArray and
+     other types convertible to ByteRange. Unlike std::hash, the object can
+     be constructed with a custom seed.
+
+     The object is "transparent", so with the ByteRangeEqual, you can look up
+     ByteArray keys in unordered containers by a ByteRange, without creating
+     a temporary key. Note that the heterogeneous lookup in unordered containers
+     requires C++20 standard library.
+     */
+    struct ByteRangeHash
+    {
+        typedef void is_transparent;
+
+        explicit ByteRangeHash(U64 seed = 0) :
+            _seed(seed)
+        {
+        }
+
+        size_t operator()(const ByteRange & data) const
+        {
+            return static_cast<size_t>(Hash64(data, _seed));
+        }
+
+        U64 seed() const
+        {
+            return _seed;
+        }
+
+    private:
+        U64 _seed;
+    };
+
+    /**
+     The ByteRangeEqual is an equality function object for ByteRange, ByteArray
+     and other types convertible to ByteRange.
+     */
+    struct ByteRangeEqual
+    {
+        typedef void is_transparent;
+
+        bool operator()(const ByteRange & x, const ByteRange & y) const
+        {
+            return x == y;
+        }
+    };
+
+} // cc7
+
+namespace std
+{
+    /**
+     Specialization of std::hash for cc7::ByteRange. The hash is calculated
+     with zero seed.
+     */
+    template <> struct hash<cc7::ByteRange>
+    {
+        size_t operator()(const cc7::ByteRange & data) const
+        {
+            return static_cast<size_t>(cc7::Hash64(data));
+        }
+    };
+
+    /**
+     Specialization of std::hash for cc7::ByteArray. The hash value is the same
+     as for ByteRange with equal content.
+     */
+    template <> struct hash<cc7::ByteArray>
+    {
+        size_t operator()(const cc7::ByteArray & data) const
+        {
+            return static_cast<size_t>(cc7::Hash64(data.byteRange()));
+        }
+    };
+
+} // std
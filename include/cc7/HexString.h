@@ -20,6 +20,9 @@
 
 namespace cc7
 {
+    class ByteChain;
+    class MutableByteRange;
+    
     /**
      Converts input byte range into hexadecimal upper, or lowercase string. 
      The function always returns true.
@@ -32,6 +35,27 @@ namespace cc7
      */
     bool HexString_Decode(const std::string & in_string, ByteArray & out_data);
     
+    /**
+     Converts hexadecimal encoded string into the provided buffer and sets |out_size|
+     to the number of decoded bytes. The function doesn't allocate memory. Returns false
+     if the input string is not a valid hexadecimal string, or if the buffer is shorter
+     than (in_string.size() + 1) / 2 bytes.
+     */
+    bool HexString_Decode(const std::string & in_string, MutableByteRange out_buffer, size_t & out_size);
+    
+    /**
+     Converts all segments from the chain into hexadecimal upper, or lowercase
+     string. The function always returns true.
+     */
+    bool HexString_Encode(const ByteChain & in_chain, bool use_lowercase, std::string & out_string);
+    
+    /**
+     Converts hexadecimal encoded string and appends the decoded bytes to the chain,
+     as a new owned segment. Returns false if the input string is not a valid
+     hexadecimal string. In this case, the chain is not modified.
+     */
+    bool HexString_Decode(const std::string & in_string, ByteChain & out_chain);
+    
     /**
      Converts input byte range into hexadecimal upper, or lowercase string. 
      This variant of encoding function may be easier to use, but unlike 
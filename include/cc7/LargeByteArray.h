@@ -0,0 +1,242 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+
+namespace cc7
+{
+    //
+    // The LargeByteArray class is a growable byte buffer, designed for data
+    // with hundreds of megabytes. The ByteArray's reallocation always copies
+    // the whole content to a new block and then wipes the old one. That's
+    // O(n) work on every growth, and for a short time the process needs twice
+    // as much memory.
+    //
+    // The LargeByteArray keeps small content in a regular ByteArray. Once
+    // the size exceeds MAPPING_THRESHOLD, the content is moved to a page
+    // aligned anonymous memory mapping. On Linux and Android, the mapping is
+    // then grown with mremap(), so the kernel only moves the pages, without
+    // a copy, and there's no old block which has to be wiped. On other platforms,
+    // a new mapping is created and the content is copied, like in ByteArray.
+    //
+    // The object keeps track of bytes which have been ever written, so only
+    // those are securely cleaned when the memory is released. The untouched
+    // pages are never accessed.
+    //
+
+    class LargeByteArray
+    {
+    public:
+
+        // STL container compatibility
+        typedef cc7::byte                   value_type;
+        typedef cc7::byte*                  pointer;
+        typedef const cc7::byte*            const_pointer;
+        typedef cc7::byte&                  reference;
+        typedef const cc7::byte&            const_reference;
+        typedef size_t                      size_type;
+        typedef cc7::byte*                  iterator;
+        typedef const cc7::byte*            const_iterator;
+
+        typedef cc7::detail::ExceptionsWrapper<value_type> _ValueTypeExceptions;
+
+        /**
+         The size, over which the content is moved from ByteArray to the memory mapping.
+         */
+        static const size_t MAPPING_THRESHOLD = 1024 * 1024;
+
+        // Construction
+
+        LargeByteArray() noexcept :
+            _mapped(nullptr),
+            _size(0),
+            _capacity(0),
+            _touched(0)
+        {
+        }
+
+        ~LargeByteArray()
+        {
+            secureClear();
+        }
+
+        LargeByteArray(const LargeByteArray &) = delete;
+        LargeByteArray & operator=(const LargeByteArray &) = delete;
+
+        LargeByteArray(LargeByteArray && other) noexcept;
+        LargeByteArray & operator=(LargeByteArray && other) noexcept;
+
+        // Data access
+
+        pointer data() noexcept
+        {
+            return _mapped ? _mapped : _small.data();
+        }
+
+        const_pointer data() const noexcept
+        {
+            return _mapped ? _mapped : _small.data();
+        }
+
+        size_type size() const noexcept
+        {
+            return _mapped ? _size : _small.size();
+        }
+
+        size_type length() const noexcept
+        {
+            return size();
+        }
+
+        size_type capacity() const noexcept
+        {
+            return _mapped ? _capacity : _small.capacity();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        /**
+         Returns true if the content is stored in the memory mapping.
+         */
+        bool isMapped() const noexcept
+        {
+            return _mapped != nullptr;
+        }
+
+        reference operator[](size_type index) noexcept
+        {
+            return data()[index];
+        }
+
+        const_reference operator[](size_type index) const noexcept
+        {
+            return data()[index];
+        }
+
+        const_reference at(size_type index) const
+        {
+            if (index < size()) {
+                return data()[index];
+            }
+            return _ValueTypeExceptions::out_of_range();
+        }
+
+        iterator begin() noexcept
+        {
+            return data();
+        }
+
+        iterator end() noexcept
+        {
+            return data() + size();
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        ByteRange byteRange() const noexcept
+        {
+            return ByteRange(data(), size());
+        }
+
+        operator ByteRange () const noexcept
+        {
+            return byteRange();
+        }
+
+        // Modifications
+
+        /**
+         Makes sure that the array can keep at least |new_capacity| bytes without
+         further reallocation.
+         */
+        void reserve(size_type new_capacity);
+
+        /**
+         Changes the size of the array. The new bytes are set to zero.
+         */
+        void resize(size_type new_size);
+
+        LargeByteArray & append(const ByteRange & range);
+
+        LargeByteArray & append(cc7::byte value)
+        {
+            return append(ByteRange(&value, 1));
+        }
+
+        /**
+         Sets the size to zero. The capacity is not changed.
+         */
+        void clear() noexcept;
+
+        /**
+         Securely cleans all bytes, which have been written to the array and releases
+         the memory. The object is empty after this call.
+         */
+        void secureClear() noexcept;
+
+        /**
+         Returns a new ByteArray with a copy of the data.
+         */
+        ByteArray copyToByteArray() const
+        {
+            return ByteArray(byteRange());
+        }
+
+    private:
+
+        void _grow(size_type required);
+        void _moveFrom(LargeByteArray & other) noexcept;
+
+        ByteArray       _small;
+        cc7::byte *     _mapped;
+        size_t          _size;
+        size_t          _capacity;
+        size_t          _touched;
+    };
+
+    // Comparison operators
+
+    inline bool operator==(const LargeByteArray & x, const LargeByteArray & y)
+    {
+        return x.byteRange() == y.byteRange();
+    }
+    inline bool operator!=(const LargeByteArray & x, const LargeByteArray & y)
+    {
+        return x.byteRange() != y.byteRange();
+    }
+
+    /**
+     Creates a new ByteRange object from given LargeByteArray.
+     */
+    inline ByteRange MakeRange(const LargeByteArray & bytes)
+    {
+        return bytes.byteRange();
+    }
+
+} // cc7
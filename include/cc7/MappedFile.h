@@ -0,0 +1,196 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteRange.h>
+
+namespace cc7
+{
+    /**
+     The MappedFile class maps the whole file into the memory and exposes its
+     content as ByteRange. Unlike reading the file into the ByteArray, the content
+     is loaded lazily by the operating system, and there's no extra copy of data.
+
+     The file can be mapped in two modes:
+
+      - ReadOnly mode, which is the default. The content is shared with the page
+        cache and any attempt to modify the memory causes a crash.
+
+      - CopyOnWrite mode, which creates a private mapping. You can modify
+        the content via the mutableData() pointer, but the changes are never
+        written back to the file. Only the modified pages consume private memory.
+
+     Note that the mapping reflects the changes in the file made by other processes,
+     so the file should not be modified, or truncated, while it's mapped. Also note
+     that in CopyOnWrite mode, the modified pages may contain sensitive data and
+     are not securely cleaned when the mapping is closed.
+     */
+    class MappedFile
+    {
+    public:
+
+        enum Mode
+        {
+            ReadOnly,
+            CopyOnWrite
+        };
+
+        enum AccessPattern
+        {
+            /**
+             No special access pattern is expected.
+             */
+            Normal,
+            /**
+             The file will be processed from the beginning to the end. The system
+             may read ahead more aggressively and release already processed pages.
+             */
+            Sequential,
+            /**
+             The file will be accessed in random order. The read ahead is disabled.
+             */
+            Random
+        };
+
+        /**
+         The Options structure contains parameters for mapping the file.
+         */
+        struct Options
+        {
+            /// Mapping mode.
+            Mode            mode;
+            /// Expected access pattern, passed to the system as a hint.
+            AccessPattern   access;
+            /// If true, then the system is asked to start loading the whole file immediately.
+            bool            will_need;
+            /// If true, then the system is asked to back the mapping with huge pages,
+            /// if supported by the platform and file system.
+            bool            huge_pages;
+
+            Options() :
+                mode        (ReadOnly),
+                access      (Sequential),
+                will_need   (false),
+                huge_pages  (false)
+            {
+            }
+        };
+
+        MappedFile() :
+            _data(nullptr),
+            _size(0),
+            _mode(ReadOnly),
+            _is_open(false)
+        {
+        }
+
+        ~MappedFile()
+        {
+            close();
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile & operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile && other);
+        MappedFile & operator=(MappedFile && other);
+
+        /**
+         Maps the file at |path| into the memory. Returns false if the file cannot
+         be opened or mapped. The previously mapped file is closed.
+         */
+        bool open(const std::string & path, const Options & options = Options());
+
+#if !defined(CC7_WINDOWS)
+        /**
+         Maps the whole file represented by the file descriptor. The descriptor
+         must be opened for reading and the function doesn't take its ownership.
+         You can close the descriptor once the function returns.
+         */
+        bool openDescriptor(int fd, const Options & options = Options());
+#endif
+
+        /**
+         Unmaps the file.
+         */
+        void close();
+
+        /**
+         Returns true if the file is mapped. Note that the empty file is also
+         treated as opened, but with no data.
+         */
+        bool isOpen() const
+        {
+            return _is_open;
+        }
+
+        Mode mode() const
+        {
+            return _mode;
+        }
+
+        const cc7::byte * data() const
+        {
+            return _data;
+        }
+
+        /**
+         Returns writable pointer to the mapped data, or nullptr if the file
+         is not mapped in CopyOnWrite mode.
+         */
+        cc7::byte * mutableData()
+        {
+            return _mode == CopyOnWrite ? _data : nullptr;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        ByteRange byteRange() const
+        {
+            return ByteRange(_data, _size);
+        }
+
+        operator ByteRange () const
+        {
+            return byteRange();
+        }
+
+        /**
+         Passes a new access pattern hint to the system, for |length| bytes
+         starting at |offset|. Returns false if the hint is not supported.
+         */
+        bool advise(AccessPattern access, size_t offset = 0, size_t length = (size_t)-1);
+
+    private:
+
+        void _moveFrom(MappedFile & other);
+
+        cc7::byte *     _data;
+        size_t          _size;
+        Mode            _mode;
+        bool            _is_open;
+    };
+
+} // cc7
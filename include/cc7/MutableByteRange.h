@@ -0,0 +1,294 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+
+namespace cc7
+{
+    //
+    // The MutableByteRange is a non-owning view to a writable sequence
+    // of bytes, like ByteRange, but allows modification of the bytes.
+    // The range can be created from a ByteArray or from a raw buffer. Like
+    // for ByteRange, you have to make sure that the underlying memory
+    // outlives the range. Any change of the ByteArray's size may invalidate
+    // the range.
+    //
+    // The class also provides vectorized in-place transformations, so you
+    // don't need to create a new ByteArray for masking, keystream XOR, or for
+    // merging bitmaps.
+    //
+
+    class MutableByteRange
+    {
+    public:
+
+        // STL container compatibility
+        typedef cc7::byte           value_type;
+        typedef cc7::byte*          pointer;
+        typedef const cc7::byte*    const_pointer;
+        typedef cc7::byte&          reference;
+        typedef const cc7::byte&    const_reference;
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+        typedef cc7::byte*          iterator;
+        typedef const cc7::byte*    const_iterator;
+
+        typedef cc7::detail::ExceptionsWrapper<value_type>          _ValueTypeExceptions;
+        typedef cc7::detail::ExceptionsWrapper<MutableByteRange>    _MutableByteRangeExceptions;
+
+        // Constructors
+
+        MutableByteRange() noexcept :
+            _begin (nullptr),
+            _end   (nullptr)
+        {
+        }
+
+        explicit MutableByteRange(pointer ptr, size_type size) noexcept :
+            _begin (ptr),
+            _end   (ptr != nullptr ? ptr + size : nullptr)
+        {
+        }
+
+        explicit MutableByteRange(void * ptr, size_type size) noexcept :
+            _begin (reinterpret_cast<pointer>(ptr)),
+            _end   (_begin ? _begin + size : nullptr)
+        {
+        }
+
+        explicit MutableByteRange(ByteArray & array) noexcept :
+            _begin (array.data()),
+            _end   (array.data() + array.size())
+        {
+        }
+
+        // Data access
+
+        pointer data() const noexcept
+        {
+            return _begin;
+        }
+
+        size_type size() const noexcept
+        {
+            return _end - _begin;
+        }
+
+        size_type length() const noexcept
+        {
+            return _end - _begin;
+        }
+
+        bool empty() const noexcept
+        {
+            return _begin == _end;
+        }
+
+        reference operator[](size_type index) const noexcept
+        {
+            if (index < size()) {
+                return _begin[index];
+            }
+            return _ValueTypeExceptions::forbidden_value();
+        }
+
+        reference at(size_type index) const
+        {
+            if (index < size()) {
+                return _begin[index];
+            }
+            return _ValueTypeExceptions::out_of_range();
+        }
+
+        iterator begin() const noexcept
+        {
+            return _begin;
+        }
+
+        iterator end() const noexcept
+        {
+            return _end;
+        }
+
+        ByteRange byteRange() const noexcept
+        {
+            return ByteRange(_begin, size());
+        }
+
+        operator ByteRange () const noexcept
+        {
+            return byteRange();
+        }
+
+        // Prefix / Suffix remove, SubRange
+
+        void removePrefix(size_type count)
+        {
+            if (count <= size()) {
+                _begin += count;
+            } else {
+                _ValueTypeExceptions::out_of_range();
+            }
+        }
+
+        void removeSuffix(size_type count)
+        {
+            if (count <= size()) {
+                _end -= count;
+            } else {
+                _ValueTypeExceptions::out_of_range();
+            }
+        }
+
+        MutableByteRange subRange(size_type from, size_type count) const
+        {
+            if ((from <= size()) && (count <= size() - from)) {
+                return MutableByteRange(_begin + from, count);
+            }
+            return _MutableByteRangeExceptions::out_of_range();
+        }
+
+        MutableByteRange subRangeFrom(size_type from) const
+        {
+            if (from <= size()) {
+                return MutableByteRange(_begin + from, size() - from);
+            }
+            return _MutableByteRangeExceptions::out_of_range();
+        }
+
+        MutableByteRange subRangeTo(size_type to) const
+        {
+            if (to <= size()) {
+                return MutableByteRange(_begin, to);
+            }
+            return _MutableByteRangeExceptions::out_of_range();
+        }
+
+        // Exception-free variants, see ByteRange for details.
+
+        bool tryRemovePrefix(size_type count) noexcept
+        {
+            if (count <= size()) {
+                _begin += count;
+                return true;
+            }
+            return false;
+        }
+
+        bool tryRemoveSuffix(size_type count) noexcept
+        {
+            if (count <= size()) {
+                _end -= count;
+                return true;
+            }
+            return false;
+        }
+
+        bool trySubRangeFrom(size_type from, MutableByteRange & out_range) const noexcept
+        {
+            if (from <= size()) {
+                out_range = MutableByteRange(_begin + from, size() - from);
+                return true;
+            }
+            return false;
+        }
+
+        bool trySubRangeTo(size_type to, MutableByteRange & out_range) const noexcept
+        {
+            if (to <= size()) {
+                out_range = MutableByteRange(_begin, to);
+                return true;
+            }
+            return false;
+        }
+
+        bool trySubRange(size_type from, size_type count, MutableByteRange & out_range) const noexcept
+        {
+            if ((from <= size()) && (count <= size() - from)) {
+                out_range = MutableByteRange(_begin + from, count);
+                return true;
+            }
+            return false;
+        }
+
+        // In-place transformations
+
+        /**
+         Copies |source| to the beginning of the range. The source must not be longer
+         than the range and may overlap with the range.
+         */
+        void copyFrom(const ByteRange & source);
+
+        /**
+         XORs all bytes in the range with the corresponding bytes from |other|.
+         The |other| range must be at least as long as this range, the remaining
+         bytes are ignored. The ranges may point to the same memory, but must not
+         partially overlap.
+         */
+        void xorWith(const ByteRange & other);
+
+        /**
+         ANDs all bytes in the range with the corresponding bytes from |other|.
+         The same rules as for xorWith() apply.
+         */
+        void andWith(const ByteRange & other);
+
+        /**
+         ORs all bytes in the range with the corresponding bytes from |other|.
+         The same rules as for xorWith() apply.
+         */
+        void orWith(const ByteRange & other);
+
+        /**
+         XORs all bytes in the range with the |pattern|, which is repeated over
+         the whole range. This is useful for example for the WebSocket masking.
+         The pattern must not be empty.
+         */
+        void xorWithPattern(const ByteRange & pattern);
+
+        /**
+         Sets all bytes in the range to |value|.
+         */
+        void fill(value_type value) noexcept;
+
+        /**
+         Reverses the order of bytes in the range.
+         */
+        void reverse() noexcept;
+
+        /**
+         Rotates the bytes in the range to the left, so the byte at |count| position
+         becomes the first byte. The |count| must not be greater than size().
+         */
+        void rotate(size_type count);
+
+    private:
+
+        pointer _begin;
+        pointer _end;
+    };
+
+    /**
+     Creates a new MutableByteRange object from given ByteArray.
+     */
+    inline MutableByteRange MakeMutableRange(ByteArray & bytes)
+    {
+        return MutableByteRange(bytes);
+    }
+
+} // cc7
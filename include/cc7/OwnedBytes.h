@@ -0,0 +1,288 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+
+namespace cc7
+{
+    //
+    // The OwnedBytes class is a move-only owner of a memory block, which has
+    // been allocated outside of cc7, for example by OpenSSL, by JNI, or by
+    // a plain malloc(). The block is adopted together with its deleter, so no
+    // copy into the ByteArray is required. When the object is destroyed, then
+    // the memory is securely cleaned (unless the NoWipe policy is used) and
+    // then the deleter is called.
+    //
+    // You can also release the storage back to the C code. In this case, the
+    // caller becomes responsible for the memory and must use a matching deleter.
+    // The memory allocated with OwnedBytes::allocate() or OwnedBytes::copyFrom()
+    // can always be released with free().
+    //
+    // Example:
+    //
+    //      BUF_MEM * mem;
+    //      BIO_get_mem_ptr(bio, &mem);
+    //      BIO_set_close(bio, BIO_NOCLOSE);    // BIO_free() keeps the BUF_MEM alive
+    //      BIO_free(bio);
+    //      OwnedBytes bytes = OwnedBytes::adopt(mem->data, mem->length, [](cc7::byte *, size_t, void * context) {
+    //          BUF_MEM_free(static_cast<BUF_MEM*>(context));
+    //      }, mem);
+    //
+
+    class OwnedBytes
+    {
+    public:
+
+        // STL container compatibility
+        typedef cc7::byte                   value_type;
+        typedef cc7::byte*                  pointer;
+        typedef const cc7::byte*            const_pointer;
+        typedef cc7::byte&                  reference;
+        typedef const cc7::byte&            const_reference;
+        typedef size_t                      size_type;
+        typedef cc7::byte*                  iterator;
+        typedef const cc7::byte*            const_iterator;
+
+        typedef cc7::detail::ExceptionsWrapper<value_type> _ValueTypeExceptions;
+
+        /**
+         The Deleter is a function, which releases the adopted memory block. The |context|
+         is an opaque pointer provided together with the deleter. The plain function
+         pointer (unlike std::function) never allocates, so the object can be moved
+         and released without throwing.
+         */
+        typedef void (*Deleter)(cc7::byte * ptr, size_t size, void * context);
+
+        /**
+         The WipePolicy defines whether the memory is securely cleaned before
+         the deleter is called.
+         */
+        enum WipePolicy
+        {
+            /**
+             The memory is securely cleaned before it's passed to the deleter.
+             */
+            Wipe,
+            /**
+             The memory is passed to the deleter as it is. Use this policy for
+             a read-only memory, or if the deleter wipes the memory on its own.
+             */
+            NoWipe
+        };
+
+        // Construction
+
+        OwnedBytes() noexcept :
+            _data(nullptr),
+            _size(0),
+            _deleter(nullptr),
+            _context(nullptr),
+            _policy(Wipe)
+        {
+        }
+
+        ~OwnedBytes()
+        {
+            reset();
+        }
+
+        OwnedBytes(const OwnedBytes &) = delete;
+        OwnedBytes & operator=(const OwnedBytes &) = delete;
+
+        OwnedBytes(OwnedBytes && other) noexcept :
+            _data(other._data),
+            _size(other._size),
+            _deleter(other._deleter),
+            _context(other._context),
+            _policy(other._policy)
+        {
+            other._data = nullptr;
+            other._size = 0;
+        }
+
+        OwnedBytes & operator=(OwnedBytes && other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                _data    = other._data;
+                _size    = other._size;
+                _deleter = other._deleter;
+                _context = other._context;
+                _policy  = other._policy;
+                other._data = nullptr;
+                other._size = 0;
+            }
+            return *this;
+        }
+
+        /**
+         Adopts |size| bytes at |ptr|. The |deleter| will be called with the |context|
+         once the memory is no longer needed. If you provide nullptr |ptr|, then the
+         deleter is not stored and an empty object is returned.
+         */
+        static OwnedBytes adopt(void * ptr, size_t size, Deleter deleter, void * context = nullptr, WipePolicy policy = Wipe);
+
+        /**
+         Adopts |size| bytes at |ptr|, allocated with malloc(), calloc() or realloc().
+         */
+        static OwnedBytes adoptMalloc(void * ptr, size_t size, WipePolicy policy = Wipe);
+
+        /**
+         Allocates a new block of |size| bytes with malloc(). The content of the
+         block is not initialized.
+         */
+        static OwnedBytes allocate(size_t size);
+
+        /**
+         Allocates a new block with malloc() and copies all bytes from the range.
+         */
+        static OwnedBytes copyFrom(const ByteRange & range);
+
+        // Data access
+
+        pointer data() noexcept
+        {
+            return _data;
+        }
+
+        const_pointer data() const noexcept
+        {
+            return _data;
+        }
+
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        size_type length() const noexcept
+        {
+            return _size;
+        }
+
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        reference operator[](size_type index) noexcept
+        {
+            return _data[index];
+        }
+
+        const_reference operator[](size_type index) const noexcept
+        {
+            return _data[index];
+        }
+
+        const_reference at(size_type index) const
+        {
+            if (index < _size) {
+                return _data[index];
+            }
+            return _ValueTypeExceptions::out_of_range();
+        }
+
+        iterator begin() noexcept
+        {
+            return _data;
+        }
+
+        iterator end() noexcept
+        {
+            return _data + _size;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return _data;
+        }
+
+        const_iterator end() const noexcept
+        {
+            return _data + _size;
+        }
+
+        ByteRange byteRange() const noexcept
+        {
+            return ByteRange(_data, _size);
+        }
+
+        operator ByteRange () const noexcept
+        {
+            return byteRange();
+        }
+
+        WipePolicy wipePolicy() const noexcept
+        {
+            return _policy;
+        }
+
+        // Ownership
+
+        /**
+         Releases the ownership of the memory block. The caller becomes responsible
+         for the returned memory and must release it with the deleter and its context,
+         which are optionally returned in |out_deleter| and |out_context|. If the object
+         is empty, then returns nullptr.
+         */
+        cc7::byte * release(Deleter * out_deleter = nullptr, void ** out_context = nullptr) noexcept;
+
+        /**
+         Securely cleans (depending on the wipe policy) and deletes the memory block.
+         The object is empty after this call.
+         */
+        void reset() noexcept;
+
+        /**
+         Returns a new ByteArray with a copy of the data.
+         */
+        ByteArray copyToByteArray() const
+        {
+            return ByteArray(byteRange());
+        }
+
+    private:
+
+        cc7::byte *     _data;
+        size_t          _size;
+        Deleter         _deleter;
+        void *          _context;
+        WipePolicy      _policy;
+    };
+
+    // Comparison operators
+
+    inline bool operator==(const OwnedBytes & x, const OwnedBytes & y)
+    {
+        return x.byteRange() == y.byteRange();
+    }
+    inline bool operator!=(const OwnedBytes & x, const OwnedBytes & y)
+    {
+        return x.byteRange() != y.byteRange();
+    }
+
+    /**
+     Creates a new ByteRange object from given OwnedBytes.
+     */
+    inline ByteRange MakeRange(const OwnedBytes & bytes)
+    {
+        return bytes.byteRange();
+    }
+
+} // cc7
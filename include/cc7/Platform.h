@@ -107,8 +107,7 @@
     #include <string.h>
     //
     #define CC7_ANDROID
-    CC7_EXTERN_C void OPENSSL_cleanse(void *ptr, size_t len);
-    #define CC7_SecureClean(ptr, size)  OPENSSL_cleanse(ptr, size)
+    #define CC7_SecureClean(ptr, size)  CC7SecureCleanImpl(ptr, size)
     // 64 bit
     #if __SIZEOF_POINTER__ == 8
         #define CC7_PLATFORM64
@@ -121,6 +120,31 @@
     // Interface deprecation
     #define CC7_DEPRECATED(deprecated_in_version) __attribute__((deprecated))
     //
+#elif defined(__linux__)
+    // -------------------------------------------------------------------
+    // LINUX PLATFORM
+    // -------------------------------------------------------------------
+    #include <stdlib.h>
+    #include <string.h>
+    //
+    #define CC7_LINUX
+    #define CC7_SecureClean(ptr, size)  CC7SecureCleanImpl(ptr, size)
+    // 64 bit
+    #if __SIZEOF_POINTER__ == 8
+        #define CC7_PLATFORM64
+    #else
+        #define CC7_PLATFORM32
+    #endif
+    // Little / Big endian
+    #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        #define CC7_BIG_ENDIAN
+    #else
+        #define CC7_LITTLE_ENDIAN
+    #endif
+    #define CC7_UNUSED_VAR  __attribute__((unused))
+    // Interface deprecation
+    #define CC7_DEPRECATED(deprecated_in_version) __attribute__((deprecated))
+    //
 #elif defined(WINAPI_FAMILY) && WINAPI_FAMILY == WINAPI_FAMILY_PHONE_APP
     // -------------------------------------------------------------------
     // Windows8+ Phone
@@ -157,6 +181,18 @@
     //
 #endif // end of platform switch
 
+// =======================================================================
+// Secure memory cleanup
+// =======================================================================
+
+//
+// CC7SecureCleanImpl() is a cc7's own implementation of secure memory
+// cleanup, which is used for CC7_SecureClean() macro on platforms which
+// doesn't provide fast enough system function.
+//
+#include <stddef.h>
+CC7_EXTERN_C void CC7SecureCleanImpl(void * ptr, size_t size);
+
 // =======================================================================
 // Setup for implicit features
 // =======================================================================
@@ -231,6 +267,10 @@
         #define CC7_BREAKPOINT()
     #endif // CC7_ANDROID
 
+    #ifdef CC7_LINUX
+        #define CC7_BREAKPOINT()
+    #endif // CC7_LINUX
+
     #ifdef CC7_WINDOWS
         #define CC7_BREAKPOINT()
     #endif // CC7_WINDOWS
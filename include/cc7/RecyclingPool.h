@@ -0,0 +1,145 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/BasicByteArray.h>
+
+namespace cc7
+{
+    /**
+     The RecyclingPool is an allocator for small, short living secure buffers.
+     Each released block is securely cleaned and then kept in a free list of the
+     current thread, so the next allocation of the same size class is served
+     without calling malloc() and without taking any lock.
+
+     The size classes are 16, 32, 64, 128 and 256 bytes. Larger blocks are
+     allocated directly with malloc() and securely cleaned before free().
+
+     If the thread's free list grows over THREAD_CACHE_LIMIT blocks, then
+     a half of the list is moved to the global depot. The depot is a lock-free
+     stack, shared between all threads. When the thread's free list is empty,
+     then it's refilled from the depot. When the thread finishes, then all its
+     blocks are moved to the depot. The depot keeps up to DEPOT_LIMIT blocks
+     per size class, all blocks over this limit are released to the system.
+     */
+    class RecyclingPool
+    {
+    public:
+
+        static const size_t SIZE_CLASSES_COUNT  = 5;
+        static const size_t MIN_BLOCK_SIZE      = 16;
+        static const size_t MAX_BLOCK_SIZE      = MIN_BLOCK_SIZE << (SIZE_CLASSES_COUNT - 1);
+        static const size_t THREAD_CACHE_LIMIT  = 64;
+        static const size_t DEPOT_LIMIT         = 1024;
+
+        /**
+         The Statistics structure contains snapshot of pool's counters,
+         aggregated over all threads.
+         */
+        struct Statistics
+        {
+            /// Number of allocations served from the thread's free list.
+            U64     hits;
+            /// Number of allocations, which required malloc().
+            U64     misses;
+            /// Number of allocations larger than MAX_BLOCK_SIZE.
+            U64     large_allocations;
+            /// Number of times the thread's free list was refilled from the depot.
+            U64     depot_refills;
+            /// Number of times the blocks were moved from the thread to the depot.
+            U64     depot_returns;
+            /// Number of blocks released to the system, because the depot was full.
+            U64     released_blocks;
+            /// Number of blocks currently kept in the depot.
+            size_t  depot_blocks;
+        };
+
+        /**
+         Allocates a block of |size| bytes.
+         */
+        static void * allocate(size_t size);
+
+        /**
+         Securely cleans the block and returns it to the current thread's free list.
+         The |size| must be equal to the size used for the allocation.
+         */
+        static void deallocate(void * ptr, size_t size);
+
+        /**
+         Moves all blocks from the current thread's free lists to the depot.
+         */
+        static void flushThreadCache();
+
+        /**
+         Releases all blocks kept in the depot to the system.
+         */
+        static void purgeDepot();
+
+        /**
+         Returns snapshot of pool's statistics.
+         */
+        static Statistics statistics();
+    };
+
+namespace detail
+{
+    /**
+     The RecyclingAllocator is std::allocator, which allocates memory
+     from the RecyclingPool.
+     */
+    template <class T> class RecyclingAllocator : public std::allocator<T>
+    {
+    public:
+
+        template <class U> struct rebind
+        {
+            typedef RecyclingAllocator <U> other;
+        };
+
+        RecyclingAllocator() throw()
+        {
+        }
+
+        RecyclingAllocator(const RecyclingAllocator &) throw()
+        {
+        }
+
+        template <class U> RecyclingAllocator(const RecyclingAllocator <U> &) throw()
+        {
+        }
+
+        T * allocate(size_t n)
+        {
+            return static_cast<T*>(RecyclingPool::allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T * p, size_t n)
+        {
+            RecyclingPool::deallocate(p, n * sizeof(T));
+        }
+    };
+
+} // cc7::detail
+
+    /**
+     The RecycledByteArray is a ByteArray-like container, which keeps its content
+     in memory allocated from the RecyclingPool. It's suitable for short living
+     buffers up to 256 bytes, like keys, signatures or digests.
+     */
+    typedef BasicByteArray<detail::RecyclingAllocator<cc7::byte>> RecycledByteArray;
+
+} // cc7
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/BasicByteArray.h>
+#include <mutex>
+#include <unordered_map>
+
+namespace cc7
+{
+    /**
+     The SecurePagePool is an allocator for sensitive data, which keeps all allocated
+     blocks in memory pages locked in RAM. The pages are also excluded from core dumps
+     on platforms supporting MADV_DONTDUMP.
+
+     The pool maps large regions up front and carves them into fixed size classes,
+     from 16 up to 4096 bytes. Allocation and deallocation of such small blocks is
+     then just a free list operation, with no system call involved. Each released slot
+     is securely cleaned before it's returned to its free list. Blocks larger than
+     the biggest size class have their own locked mapping.
+
+     If guard pages are enabled, then each region is surrounded by inaccessible pages,
+     so linear overflow out of the region causes an immediate crash.
+
+     Note that locking the memory may fail, due to RLIMIT_MEMLOCK or platform
+     restrictions. In this case, the pool still works, but the failure is reported
+     in the statistics.
+     */
+    class SecurePagePool
+    {
+    public:
+
+        /**
+         The Config structure contains pool's configuration.
+         */
+        struct Config
+        {
+            /**
+             Size of region allocated at once for one size class. The value is
+             rounded up to the page size.
+             */
+            size_t  region_size;
+            /**
+             If true, then each region is surrounded by guard pages.
+             */
+            bool    guard_pages;
+            /**
+             If true, then all regions are locked in RAM.
+             */
+            bool    lock_memory;
+
+            Config() :
+                region_size (64 * 1024),
+                guard_pages (true),
+                lock_memory (true)
+            {
+            }
+        };
+
+        /**
+         The Statistics structure contains snapshot of pool's counters.
+         */
+        struct Statistics
+        {
+            /// Number of regions mapped for size classes.
+            size_t  regions;
+            /// Number of bytes mapped for size classes and large blocks.
+            size_t  mapped_bytes;
+            /// Number of bytes successfully locked in RAM.
+            size_t  locked_bytes;
+            /// Number of failed attempts to lock memory.
+            size_t  lock_failures;
+            /// Total number of allocations served by the pool.
+            size_t  allocations;
+            /// Total number of deallocations.
+            size_t  deallocations;
+            /// Number of allocations larger than the biggest size class.
+            size_t  large_allocations;
+            /// Number of currently used slots.
+            size_t  used_slots;
+            /// Number of currently free slots.
+            size_t  free_slots;
+            /// Number of currently used bytes, including the size class overhead.
+            size_t  used_bytes;
+        };
+
+        /**
+         Number of size classes. The classes have sizes 16, 32, 64 ... 4096 bytes.
+         */
+        static const size_t SIZE_CLASSES_COUNT  = 9;
+        static const size_t MIN_SLOT_SIZE       = 16;
+        static const size_t MAX_SLOT_SIZE       = MIN_SLOT_SIZE << (SIZE_CLASSES_COUNT - 1);
+
+        /**
+         Constructs a new pool with given configuration.
+         */
+        SecurePagePool(const Config & config = Config());
+
+        /**
+         Destroys the pool. All regions are unmapped, so you must not
+         destroy the pool while some of its blocks are still in use.
+         */
+        ~SecurePagePool();
+
+        /**
+         Returns shared instance of pool, with default configuration.
+         The shared pool is never destroyed.
+         */
+        static SecurePagePool & sharedPool();
+
+        /**
+         Allocates a block of |size| bytes. The function throws std::bad_alloc
+         (or asserts, if exceptions are disabled) if the memory cannot be mapped.
+         */
+        void * allocate(size_t size);
+
+        /**
+         Securely cleans and releases the block. The |size| must be equal to
+         the size used for the allocation.
+         */
+        void deallocate(void * ptr, size_t size);
+
+        /**
+         Returns snapshot of pool's statistics.
+         */
+        Statistics statistics() const;
+
+        /**
+         Returns pool's configuration.
+         */
+        const Config & config() const
+        {
+            return _config;
+        }
+
+    private:
+
+        // Not copyable
+        SecurePagePool(const SecurePagePool &) = delete;
+        SecurePagePool & operator=(const SecurePagePool &) = delete;
+
+        struct FreeSlot
+        {
+            FreeSlot * next;
+        };
+
+        struct Region
+        {
+            Region *    next;
+            void *      mapping;
+            size_t      mapping_size;
+            bool        locked;
+        };
+
+        void *  _mapRegion(size_t size, Region & region);
+        void    _unmapRegion(const Region & region);
+        bool    _addRegion(size_t size_class);
+
+        Config      _config;
+        size_t      _page_size;
+
+        mutable std::mutex  _lock;
+        FreeSlot *  _free_lists[SIZE_CLASSES_COUNT];
+        Region *    _regions;
+        std::unordered_map<void*, Region> _large_blocks;
+        Statistics  _stats;
+    };
+
+
+namespace detail
+{
+    /**
+     The SecurePoolAllocator is std::allocator, which allocates memory from
+     the shared SecurePagePool instance.
+     */
+    template <class T> class SecurePoolAllocator : public std::allocator<T>
+    {
+    public:
+
+        template <class U> struct rebind
+        {
+            typedef SecurePoolAllocator <U> other;
+        };
+
+        SecurePoolAllocator() throw()
+        {
+        }
+
+        SecurePoolAllocator(const SecurePoolAllocator &) throw()
+        {
+        }
+
+        template <class U> SecurePoolAllocator(const SecurePoolAllocator <U> &) throw()
+        {
+        }
+
+        T * allocate(size_t n)
+        {
+            return static_cast<T*>(SecurePagePool::sharedPool().allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T * p, size_t n)
+        {
+            SecurePagePool::sharedPool().deallocate(p, n * sizeof(T));
+        }
+    };
+
+} // cc7::detail
+
+    /**
+     The LockedByteArray is a ByteArray-like container, which keeps its content
+     in memory allocated from the shared SecurePagePool.
+     */
+    typedef BasicByteArray<detail::SecurePoolAllocator<cc7::byte>> LockedByteArray;
+
+} // cc7
@@ -0,0 +1,494 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+#include <cc7/Base64.h>
+#include <cc7/HexString.h>
+#include <cc7/MutableByteRange.h>
+
+namespace cc7
+{
+    //
+    // The SecureSmallByteArray class is a byte container with a small buffer
+    // optimization. Up to N bytes are kept in the inline storage, so typical
+    // keys, IVs or digests doesn't require any heap allocation. If the content
+    // grows over N bytes, then the buffer is allocated with the same
+    // CleanupAllocator as ByteArray uses.
+    //
+    // The inline storage is always securely cleaned when the object is destroyed,
+    // or when its content is moved to another object.
+    //
+
+    template <size_t N>
+    class SecureSmallByteArray
+    {
+    public:
+
+        static_assert(N > 0, "Inline capacity must be greater than 0");
+
+        // STL container compatibility
+        typedef cc7::byte                   value_type;
+        typedef cc7::byte*                  pointer;
+        typedef const cc7::byte*            const_pointer;
+        typedef cc7::byte&                  reference;
+        typedef const cc7::byte&            const_reference;
+        typedef size_t                      size_type;
+        typedef ptrdiff_t                   difference_type;
+        typedef cc7::byte*                  iterator;
+        typedef const cc7::byte*            const_iterator;
+        typedef detail::CleanupAllocator<cc7::byte>     allocator_type;
+
+        typedef cc7::detail::ExceptionsWrapper<value_type> _ValueTypeExceptions;
+
+        static const size_type inline_capacity = N;
+
+    private:
+
+        pointer     _data;
+        size_type   _size;
+        size_type   _capacity;
+        value_type  _inline[N];
+
+    public:
+
+        // Construction & destruction
+
+        SecureSmallByteArray() noexcept :
+            _data       (_inline),
+            _size       (0),
+            _capacity   (N)
+        {
+        }
+
+        explicit SecureSmallByteArray(size_type n, value_type val = 0) :
+            SecureSmallByteArray()
+        {
+            append(n, val);
+        }
+
+        SecureSmallByteArray(std::initializer_list<value_type> il) :
+            SecureSmallByteArray()
+        {
+            append(il.begin(), il.size());
+        }
+
+        SecureSmallByteArray(const ByteRange & range) :
+            SecureSmallByteArray()
+        {
+            append(range);
+        }
+
+        SecureSmallByteArray(const ByteArray & array) :
+            SecureSmallByteArray()
+        {
+            append(array.byteRange());
+        }
+
+        SecureSmallByteArray(const SecureSmallByteArray & other) :
+            SecureSmallByteArray()
+        {
+            append(other.byteRange());
+        }
+
+        SecureSmallByteArray(SecureSmallByteArray && other) noexcept :
+            SecureSmallByteArray()
+        {
+            _moveFrom(other);
+        }
+
+        ~SecureSmallByteArray()
+        {
+            _release();
+        }
+
+        // Assignment
+
+        SecureSmallByteArray & operator=(const SecureSmallByteArray & other)
+        {
+            if (this != &other) {
+                assign(other.byteRange());
+            }
+            return *this;
+        }
+
+        SecureSmallByteArray & operator=(SecureSmallByteArray && other) noexcept
+        {
+            if (this != &other) {
+                _release();
+                _moveFrom(other);
+            }
+            return *this;
+        }
+
+        SecureSmallByteArray & operator=(const ByteRange & range)
+        {
+            assign(range);
+            return *this;
+        }
+
+        SecureSmallByteArray & operator=(const ByteArray & array)
+        {
+            assign(array.byteRange());
+            return *this;
+        }
+
+        void assign(const ByteRange & range)
+        {
+            if (_overlaps(range)) {
+                // Assign from own content. Just move bytes to the beginning of the buffer.
+                const size_type new_size = range.size();
+                memmove(_data, range.data(), new_size);
+                if (new_size < _size) {
+                    CC7_SecureClean(_data + new_size, _size - new_size);
+                }
+                _size = new_size;
+                return;
+            }
+            CC7_SecureClean(_data, _size);
+            _size = 0;
+            append(range);
+        }
+
+        // Size & capacity
+
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        size_type length() const noexcept
+        {
+            return _size;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        /**
+         Returns true if the content is still kept in the inline storage.
+         */
+        bool isInline() const noexcept
+        {
+            return _data == _inline;
+        }
+
+        void reserve(size_type n)
+        {
+            if (n > _capacity) {
+                _reallocate(n);
+            }
+        }
+
+        void resize(size_type n, value_type val = 0)
+        {
+            if (n > _size) {
+                append(n - _size, val);
+            } else {
+                CC7_SecureClean(_data + n, _size - n);
+                _size = n;
+            }
+        }
+
+        void clear() noexcept
+        {
+            _size = 0;
+        }
+
+        void secureClear() noexcept
+        {
+            CC7_SecureClean(_data, _capacity);
+            _size = 0;
+        }
+
+        // Element access
+
+        pointer data() noexcept
+        {
+            return _data;
+        }
+
+        const_pointer data() const noexcept
+        {
+            return _data;
+        }
+
+        reference operator[](size_type index) noexcept
+        {
+            return _data[index];
+        }
+
+        const_reference operator[](size_type index) const noexcept
+        {
+            return _data[index];
+        }
+
+        reference at(size_type index)
+        {
+            if (index < _size) {
+                return _data[index];
+            }
+            return _ValueTypeExceptions::out_of_range();
+        }
+
+        const_reference at(size_type index) const
+        {
+            if (index < _size) {
+                return _data[index];
+            }
+            return _ValueTypeExceptions::out_of_range();
+        }
+
+        // STL iterators
+
+        iterator begin() noexcept               { return _data; }
+        iterator end() noexcept                 { return _data + _size; }
+        const_iterator begin() const noexcept   { return _data; }
+        const_iterator end() const noexcept     { return _data + _size; }
+        const_iterator cbegin() const noexcept  { return _data; }
+        const_iterator cend() const noexcept    { return _data + _size; }
+
+        // Appending
+
+        void push_back(value_type val)
+        {
+            append(val);
+        }
+
+        SecureSmallByteArray & append(value_type val)
+        {
+            _ensureCapacity(_size + 1);
+            _data[_size++] = val;
+            return *this;
+        }
+
+        SecureSmallByteArray & append(size_type n, value_type val)
+        {
+            _ensureCapacity(_size + n);
+            memset(_data + _size, val, n);
+            _size += n;
+            return *this;
+        }
+
+        SecureSmallByteArray & append(const_pointer p, size_type size)
+        {
+            if (size > 0) {
+                if (_overlaps(ByteRange(p, size))) {
+                    // Appending own content, the buffer may be reallocated.
+                    const size_type offset = p - _data;
+                    _ensureCapacity(_size + size);
+                    p = _data + offset;
+                } else {
+                    _ensureCapacity(_size + size);
+                }
+                memcpy(_data + _size, p, size);
+                _size += size;
+            }
+            return *this;
+        }
+
+        SecureSmallByteArray & append(const ByteRange & range)
+        {
+            return append(range.data(), range.size());
+        }
+
+        // Interaction with ByteRange & ByteArray
+
+        ByteRange byteRange() const noexcept
+        {
+            return ByteRange(_data, _size);
+        }
+
+        operator ByteRange () const noexcept
+        {
+            return byteRange();
+        }
+
+        ByteArray byteArray() const
+        {
+            return ByteArray(byteRange());
+        }
+
+        // Codecs
+
+        std::string base64String(size_t wrap_size = 0) const
+        {
+            return ToBase64String(byteRange(), wrap_size);
+        }
+
+        std::string hexString(bool lower_case = false) const
+        {
+            return ToHexString(byteRange(), lower_case);
+        }
+
+        /**
+         Decodes the Base64 string directly to the array's buffer. If the decoded
+         bytes fit into the current buffer, then no memory is allocated. Otherwise
+         the buffer is allocated once, for the worst case size. If the string is
+         invalid, then the array is empty.
+         */
+        bool readFromBase64String(const std::string & base64_string, size_t wrap_size = 0)
+        {
+            CC7_SecureClean(_data, _size);
+            _size = 0;
+            const size_type max_size = (base64_string.size() / 4) * 3;
+            size_t size;
+            if (!Base64_Decode(base64_string, wrap_size, MutableByteRange(_data, _capacity), size)) {
+                if (max_size <= _capacity) {
+                    // The string is invalid
+                    CC7_SecureClean(_data, max_size);
+                    return false;
+                }
+                // The buffer is too small, try again with the worst case size.
+                _reallocate(max_size);
+                if (!Base64_Decode(base64_string, wrap_size, MutableByteRange(_data, _capacity), size)) {
+                    CC7_SecureClean(_data, max_size);
+                    return false;
+                }
+            }
+            _size = size;
+            return true;
+        }
+
+        /**
+         Decodes the hexadecimal string directly to the array's buffer. If the string
+         is invalid, then the array is empty.
+         */
+        bool readFromHexString(const std::string & hex_string)
+        {
+            CC7_SecureClean(_data, _size);
+            _size = 0;
+            const size_type max_size = (hex_string.size() + 1) / 2;
+            reserve(max_size);
+            size_t size;
+            if (!HexString_Decode(hex_string, MutableByteRange(_data, _capacity), size)) {
+                CC7_SecureClean(_data, max_size);
+                return false;
+            }
+            _size = size;
+            return true;
+        }
+
+    private:
+
+        bool _overlaps(const ByteRange & range) const noexcept
+        {
+            return range.data() >= _data && range.data() < _data + _capacity;
+        }
+
+        void _ensureCapacity(size_type required)
+        {
+            if (required > _capacity) {
+                _reallocate(std::max(required, _capacity * 2));
+            }
+        }
+
+        void _reallocate(size_type new_capacity)
+        {
+            allocator_type allocator;
+            pointer new_data = allocator.allocate(new_capacity);
+            memcpy(new_data, _data, _size);
+            if (isInline()) {
+                CC7_SecureClean(_inline, N);
+            } else {
+                // CleanupAllocator wipes the old block
+                allocator.deallocate(_data, _capacity);
+            }
+            _data = new_data;
+            _capacity = new_capacity;
+        }
+
+        void _release() noexcept
+        {
+            if (isInline()) {
+                CC7_SecureClean(_inline, N);
+            } else {
+                allocator_type().deallocate(_data, _capacity);
+                _data = _inline;
+                _capacity = N;
+            }
+            _size = 0;
+        }
+
+        void _moveFrom(SecureSmallByteArray & other) noexcept
+        {
+            if (other.isInline()) {
+                memcpy(_inline, other._inline, other._size);
+                _size = other._size;
+                CC7_SecureClean(other._inline, N);
+            } else {
+                _data = other._data;
+                _size = other._size;
+                _capacity = other._capacity;
+                other._data = other._inline;
+                other._capacity = N;
+            }
+            other._size = 0;
+        }
+    };
+
+    template <size_t N> const size_t SecureSmallByteArray<N>::inline_capacity;
+
+    // Comparison operators
+
+    template <size_t N, size_t M>
+    inline bool operator==(const SecureSmallByteArray<N> & x, const SecureSmallByteArray<M> & y)
+    {
+        return x.byteRange() == y.byteRange();
+    }
+    template <size_t N, size_t M>
+    inline bool operator!=(const SecureSmallByteArray<N> & x, const SecureSmallByteArray<M> & y)
+    {
+        return x.byteRange() != y.byteRange();
+    }
+    template <size_t N>
+    inline bool operator==(const SecureSmallByteArray<N> & x, const ByteRange & y)
+    {
+        return x.byteRange() == y;
+    }
+    template <size_t N>
+    inline bool operator!=(const SecureSmallByteArray<N> & x, const ByteRange & y)
+    {
+        return x.byteRange() != y;
+    }
+
+    /**
+     Creates a new ByteRange object from given SecureSmallByteArray.
+     */
+    template <size_t N>
+    inline ByteRange MakeRange(const SecureSmallByteArray<N> & array)
+    {
+        return array.byteRange();
+    }
+
+    //
+    // Common specializations
+    //
+
+    /// Suitable for AES-128 & AES-256 keys and GCM IVs
+    typedef SecureSmallByteArray<32>    SecureKeyBytes;
+    /// Suitable for up to SHA-512 digests
+    typedef SecureSmallByteArray<64>    SecureDigestBytes;
+
+} // cc7
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+#include <memory>
+
+namespace cc7
+{
+    //
+    // The SharedBytes class is an immutable, reference counted byte buffer.
+    // The object is cheap to copy, and the copies can be safely passed
+    // between threads, because the reference counter is atomic.
+    //
+    // The buffer is typically created by moving the ByteArray in, so no data
+    // is copied. Each SharedBytes object can also represent only a slice of
+    // the underlying buffer, while it still shares its ownership. When the
+    // last owner is destroyed, then the buffer is securely cleaned, by the
+    // same CleanupAllocator as the ByteArray uses.
+    //
+
+    class SharedBytes
+    {
+    public:
+
+        // STL container compatibility
+        typedef cc7::byte                   value_type;
+        typedef const cc7::byte*            const_pointer;
+        typedef const cc7::byte&            const_reference;
+        typedef size_t                      size_type;
+        typedef const cc7::byte*            const_iterator;
+
+        typedef cc7::detail::ExceptionsWrapper<SharedBytes> _SharedBytesExceptions;
+
+    private:
+
+        std::shared_ptr<const ByteArray>    _storage;
+        ByteRange                           _range;
+
+        SharedBytes(const std::shared_ptr<const ByteArray> & storage, const ByteRange & range) noexcept :
+            _storage(storage),
+            _range(range)
+        {
+        }
+
+    public:
+
+        // Construction
+
+        SharedBytes() noexcept
+        {
+        }
+
+        /**
+         Constructs a new SharedBytes object by moving content of the array.
+         */
+        explicit SharedBytes(ByteArray && array) :
+            _storage(std::make_shared<const ByteArray>(std::move(array)))
+        {
+            _range = _storage->byteRange();
+        }
+
+        /**
+         Constructs a new SharedBytes object with a copy of bytes from the range.
+         */
+        explicit SharedBytes(const ByteRange & range) :
+            SharedBytes(ByteArray(range))
+        {
+        }
+
+        SharedBytes(const SharedBytes & other) = default;
+        SharedBytes & operator=(const SharedBytes & other) = default;
+
+        SharedBytes(SharedBytes && other) noexcept :
+            _storage(std::move(other._storage)),
+            _range(other._range)
+        {
+            other._range.clear();
+        }
+
+        SharedBytes & operator=(SharedBytes && other) noexcept
+        {
+            if (this != &other) {
+                _storage = std::move(other._storage);
+                _range = other._range;
+                other._range.clear();
+            }
+            return *this;
+        }
+
+        // Data access
+
+        const_pointer data() const noexcept
+        {
+            return _range.data();
+        }
+
+        size_type size() const noexcept
+        {
+            return _range.size();
+        }
+
+        size_type length() const noexcept
+        {
+            return _range.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return _range.empty();
+        }
+
+        const_reference operator[](size_type index) const noexcept
+        {
+            return _range[index];
+        }
+
+        const_reference at(size_type index) const
+        {
+            return _range.at(index);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return _range.begin();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return _range.end();
+        }
+
+        ByteRange byteRange() const noexcept
+        {
+            return _range;
+        }
+
+        operator ByteRange () const noexcept
+        {
+            return _range;
+        }
+
+        // Slicing
+
+        /**
+         Returns a new SharedBytes object, which shares ownership of the buffer,
+         but represents only |count| bytes, starting at |from| offset.
+         */
+        SharedBytes subBytes(size_type from, size_type count) const
+        {
+            if ((from <= size()) && (count <= size() - from)) {
+                return SharedBytes(_storage, ByteRange(data() + from, count));
+            }
+            return _SharedBytesExceptions::out_of_range();
+        }
+
+        SharedBytes subBytesFrom(size_type from) const
+        {
+            if (from <= size()) {
+                return SharedBytes(_storage, ByteRange(data() + from, size() - from));
+            }
+            return _SharedBytesExceptions::out_of_range();
+        }
+
+        SharedBytes subBytesTo(size_type to) const
+        {
+            if (to <= size()) {
+                return SharedBytes(_storage, ByteRange(data(), to));
+            }
+            return _SharedBytesExceptions::out_of_range();
+        }
+
+        // Ownership
+
+        /**
+         Returns number of SharedBytes objects sharing the same buffer.
+         */
+        long useCount() const noexcept
+        {
+            return _storage.use_count();
+        }
+
+        /**
+         Releases the ownership of the buffer. If this was the last owner,
+         then the buffer is securely cleaned and released.
+         */
+        void reset() noexcept
+        {
+            _storage.reset();
+            _range.clear();
+        }
+
+        /**
+         Returns a new ByteArray with a copy of the data.
+         */
+        ByteArray copyToByteArray() const
+        {
+            return ByteArray(_range);
+        }
+    };
+
+    // Comparison operators
+
+    inline bool operator==(const SharedBytes & x, const SharedBytes & y)
+    {
+        return x.byteRange() == y.byteRange();
+    }
+    inline bool operator!=(const SharedBytes & x, const SharedBytes & y)
+    {
+        return x.byteRange() != y.byteRange();
+    }
+
+    /**
+     Creates a new ByteRange object from given SharedBytes.
+     */
+    inline ByteRange MakeRange(const SharedBytes & bytes)
+    {
+        return bytes.byteRange();
+    }
+
+} // cc7
@@ -32,6 +32,24 @@ namespace utilities
         }
         return Align;
     }
+    
+    /**
+     Returns number of trailing zero bits in |value|. The value must not be zero.
+     */
+    inline size_t CountTrailingZeros(U64 value)
+    {
+        CC7_ASSERT(value != 0, "Zero is not allowed");
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+    #else
+        size_t count = 0;
+        while ((value & 1) == 0) {
+            value >>= 1;
+            count++;
+        }
+        return count;
+    #endif
+    }
 
 } // cc7::utilities
 } // cc7
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteArray.h>
+
+namespace cc7
+{
+    //
+    // Variable length integers (LEB128 varints), compatible with
+    // the protocol buffers encoding. Each byte contains 7 bits of the value,
+    // starting with the least significant group. The highest bit is set
+    // when more bytes follow.
+    //
+
+    /**
+     Maximum number of bytes required for encoding U32 value.
+     */
+    const size_t VARINT_MAX_SIZE_U32 = 5;
+    /**
+     Maximum number of bytes required for encoding U64 value.
+     */
+    const size_t VARINT_MAX_SIZE_U64 = 10;
+
+    /**
+     Returns number of bytes required for encoding |value|.
+     */
+    size_t Varint_EncodedSize(U64 value);
+
+    /**
+     Encodes |value| to |out_buffer|, which must be at least VARINT_MAX_SIZE_U64 bytes
+     long (or VARINT_MAX_SIZE_U32 for values which fit to U32). Returns number of
+     written bytes.
+     */
+    size_t Varint_Encode(U64 value, cc7::byte * out_buffer);
+
+    /**
+     Encodes |count| values from |values| array and appends the encoded bytes
+     to the |out_data|.
+     */
+    void Varint_EncodeArray(const U32 * values, size_t count, ByteArray & out_data);
+    void Varint_EncodeArray(const U64 * values, size_t count, ByteArray & out_data);
+
+    /**
+     Decodes one varint from the beginning of |in_data|. Returns false if the range
+     doesn't begin with a complete varint, or if the encoded value doesn't fit to the
+     output type. On success, |out_size| contains number of consumed bytes.
+     */
+    bool Varint_Decode(const ByteRange & in_data, U32 & out_value, size_t & out_size);
+    bool Varint_Decode(const ByteRange & in_data, U64 & out_value, size_t & out_size);
+
+    /**
+     Decodes up to |count| varints from |in_data| into |out_values| array. Returns number
+     of decoded values and |out_consumed| contains number of bytes consumed from the range.
+     If the returned value is less than |count|, then the range ended, or the next varint
+     is incomplete or doesn't fit to the output type. The |out_consumed| then points to
+     the first byte of that varint.
+
+     Unlike the sequence of Varint_Decode() calls, this function processes the input
+     in blocks of 8 or 16 bytes and decodes all varints from such block at once.
+     */
+    size_t Varint_DecodeArray(const ByteRange & in_data, U32 * out_values, size_t count, size_t & out_consumed);
+    size_t Varint_DecodeArray(const ByteRange & in_data, U64 * out_values, size_t count, size_t & out_consumed);
+
+    /**
+     Maps signed |value| to unsigned integer, so the values with small magnitude
+     have also short varint representation ("sint64" in protocol buffers).
+     */
+    inline U64 Varint_ZigZagEncode(int64_t value)
+    {
+        return (static_cast<U64>(value) << 1) ^ static_cast<U64>(value >> 63);
+    }
+
+    /**
+     Reverse function to Varint_ZigZagEncode().
+     */
+    inline int64_t Varint_ZigZagDecode(U64 value)
+    {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+} // cc7
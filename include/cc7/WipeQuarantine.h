@@ -0,0 +1,121 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/Platform.h>
+
+namespace cc7
+{
+    /**
+     The WipeQuarantine moves the secure cleanup of large memory blocks to
+     a background thread. When the quarantine is enabled, then the ByteArray's
+     allocator doesn't wipe the large blocks on the calling thread. Instead,
+     the block is queued and the background thread wipes it and then releases
+     it to the system. The block is never released (and therefore never reused)
+     before it's wiped.
+
+     The quarantine is disabled by default. The amount of memory waiting for
+     the cleanup is limited by Configuration::max_pending_bytes. If the limit
+     is reached, then the block is wiped synchronously, as usual.
+
+     You should call disable() before the application exits, to make sure
+     that all pending blocks are wiped. The flush() method waits for all
+     blocks which are currently in the quarantine.
+     */
+    class WipeQuarantine
+    {
+    public:
+
+        /**
+         Blocks smaller than this size are always wiped synchronously.
+         */
+        static const size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+        /**
+         The ReleaseFunction is called from the background thread, once the block
+         is securely cleaned. The function may free the block, or return it to a pool.
+         */
+        typedef void (*ReleaseFunction)(void * ptr, size_t size);
+
+        struct Configuration
+        {
+            /// Minimum size of block, which is moved to the quarantine. The value
+            /// is never lower than MIN_BLOCK_SIZE.
+            size_t  min_block_size;
+            /// Maximum number of bytes, waiting for the cleanup.
+            size_t  max_pending_bytes;
+
+            Configuration() :
+                min_block_size      (1024 * 1024),
+                max_pending_bytes   (256 * 1024 * 1024)
+            {
+            }
+        };
+
+        struct Statistics
+        {
+            /// Number of blocks accepted to the quarantine.
+            U64     deferred_blocks;
+            /// Number of bytes accepted to the quarantine.
+            U64     deferred_bytes;
+            /// Number of blocks rejected, because the quarantine was full.
+            U64     rejected_blocks;
+            /// Number of blocks already wiped and released.
+            U64     released_blocks;
+            /// Number of bytes currently waiting for the cleanup.
+            size_t  pending_bytes;
+            /// Highest number of bytes, which have been waiting for the cleanup.
+            size_t  peak_pending_bytes;
+        };
+
+        /**
+         Starts the background thread and enables the quarantine. If the quarantine
+         is already enabled, then only the configuration is changed.
+         */
+        static void enable(const Configuration & config = Configuration());
+
+        /**
+         Wipes and releases all pending blocks, then stops the background thread.
+         */
+        static void disable();
+
+        /**
+         Returns true if the quarantine is enabled.
+         */
+        static bool isEnabled();
+
+        /**
+         Moves |size| bytes at |ptr| to the quarantine. Returns false if the block
+         has not been accepted, because the quarantine is disabled, the block is too
+         small, or the quarantine is full. In this case, the caller is responsible
+         for the cleanup.
+         */
+        static bool submit(void * ptr, size_t size, ReleaseFunction release);
+
+        /**
+         Blocks the calling thread until all blocks, which are currently in
+         the quarantine, are wiped and released.
+         */
+        static void flush();
+
+        /**
+         Returns snapshot of quarantine's statistics.
+         */
+        static Statistics statistics();
+    };
+
+} // cc7
@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include <cc7/Platform.h>
+#include <cc7/AllocationStats.h>
+#include <cc7/WipeQuarantine.h>
 
 namespace cc7
 {
@@ -25,6 +26,12 @@ namespace detail
     /**
      The CleanupAllocator is a special std::allocator, which only purpose
      is to secure clean the allocated memory, before the deallocation.
+     
+     If the library is compiled with ENABLE_CC7_ALLOCATION_STATS, then
+     the allocator also updates the allocation statistics.
+     
+     If the WipeQuarantine is enabled, then the large blocks are wiped
+     and released later, on the quarantine's background thread.
      */
     template <class T> class CleanupAllocator : public std::allocator<T>
     {
@@ -47,11 +54,46 @@ namespace detail
         {
         }
         
+        T * allocate(size_t n)
+        {
+            AllocationStats_OnAllocate(n * sizeof(T));
+            return std::allocator <T>::allocate(n);
+        }
+        
+        /**
+         Constructs the element with default initialization. For bytes, that means
+         no initialization at all, so ByteArray::resizeUninitialized() doesn't touch
+         the memory. The ByteArray's constructors, resize() and emplace methods
+         use an explicit zero value instead.
+         */
+        template <class U> void construct(U * p)
+        {
+            ::new (static_cast<void*>(p)) U;
+        }
+        
+        template <class U, class... Args> void construct(U * p, Args&&... args)
+        {
+            ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+        
         void deallocate(T * p,  size_t n)
         {
-            CC7_SecureClean(p, n * sizeof(T));
+            const size_t size = n * sizeof(T);
+            AllocationStats_OnDeallocate(size);
+            if (size >= WipeQuarantine::MIN_BLOCK_SIZE && WipeQuarantine::submit(p, size, &CleanupAllocator::_releaseWiped)) {
+                return;
+            }
+            CC7_SecureClean(p, size);
+            AllocationStats_OnWipe(size, false);
             std::allocator <T>::deallocate(p, n);
         }
+        
+    private:
+        
+        static void _releaseWiped(void * ptr, size_t size)
+        {
+            std::allocator<T>().deallocate(static_cast<T*>(ptr), size / sizeof(T));
+        }
     };
     
 } // cc7::detail
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cc7/ByteRange.h>
+
+namespace cc7
+{
+namespace detail
+{
+    //
+    // The ConcatExpression is a lazy concatenation of ByteRange objects and
+    // single bytes. The expression is produced by operator+ and doesn't copy
+    // any data. The result is materialized once, when the expression is
+    // assigned or appended to the ByteArray. At that point, the total size is
+    // known, so the target buffer is allocated only once and each segment
+    // is copied exactly once.
+    //
+    // Like the ByteRange, the expression doesn't own the concatenated data,
+    // so all captured buffers must be alive until the expression is used.
+    //
+
+    template <class Left, class Right> class ConcatExpression;
+
+    // Segment size
+
+    inline size_t ConcatSegmentSize(const ByteRange & range)
+    {
+        return range.size();
+    }
+
+    inline size_t ConcatSegmentSize(cc7::byte)
+    {
+        return 1;
+    }
+
+    template <class Left, class Right>
+    inline size_t ConcatSegmentSize(const ConcatExpression<Left, Right> & expr)
+    {
+        return expr.size();
+    }
+
+    // Segment append
+
+    template <class Container>
+    inline void ConcatSegmentAppend(Container & c, const ByteRange & range)
+    {
+        c.insert(c.end(), range.begin(), range.end());
+    }
+
+    template <class Container>
+    inline void ConcatSegmentAppend(Container & c, cc7::byte b)
+    {
+        c.push_back(b);
+    }
+
+    template <class Container, class Left, class Right>
+    inline void ConcatSegmentAppend(Container & c, const ConcatExpression<Left, Right> & expr)
+    {
+        expr.appendTo(c);
+    }
+
+    template <class Left, class Right>
+    class ConcatExpression
+    {
+    public:
+
+        ConcatExpression(const Left & left, const Right & right) :
+            _left(left),
+            _right(right)
+        {
+        }
+
+        /**
+         Returns total number of bytes in the expression.
+         */
+        size_t size() const
+        {
+            return ConcatSegmentSize(_left) + ConcatSegmentSize(_right);
+        }
+
+        /**
+         Appends all segments to the container. The function doesn't reserve
+         capacity in the container, that's responsibility of the caller.
+         */
+        template <class Container>
+        void appendTo(Container & c) const
+        {
+            ConcatSegmentAppend(c, _left);
+            ConcatSegmentAppend(c, _right);
+        }
+
+    private:
+
+        Left    _left;
+        Right   _right;
+    };
+
+} // cc7::detail
+
+    //
+    // Concatenation operators
+    //
+
+    inline detail::ConcatExpression<ByteRange, ByteRange> operator+(const ByteRange & left, const ByteRange & right)
+    {
+        return detail::ConcatExpression<ByteRange, ByteRange>(left, right);
+    }
+
+    inline detail::ConcatExpression<ByteRange, cc7::byte> operator+(const ByteRange & left, cc7::byte right)
+    {
+        return detail::ConcatExpression<ByteRange, cc7::byte>(left, right);
+    }
+
+    inline detail::ConcatExpression<cc7::byte, ByteRange> operator+(cc7::byte left, const ByteRange & right)
+    {
+        return detail::ConcatExpression<cc7::byte, ByteRange>(left, right);
+    }
+
+    template <class L, class R>
+    inline detail::ConcatExpression<detail::ConcatExpression<L, R>, ByteRange>
+        operator+(const detail::ConcatExpression<L, R> & left, const ByteRange & right)
+    {
+        return detail::ConcatExpression<detail::ConcatExpression<L, R>, ByteRange>(left, right);
+    }
+
+    template <class L, class R>
+    inline detail::ConcatExpression<detail::ConcatExpression<L, R>, cc7::byte>
+        operator+(const detail::ConcatExpression<L, R> & left, cc7::byte right)
+    {
+        return detail::ConcatExpression<detail::ConcatExpression<L, R>, cc7::byte>(left, right);
+    }
+
+} // cc7
@@ -53,7 +53,22 @@ LOCAL_SRC_FILES := \
 	cc7/ByteArray.cpp \
 	cc7/Base32.cpp \
 	cc7/Base64.cpp \
-	cc7/HexString.cpp
+	cc7/HexString.cpp \
+	cc7/SecureClean.cpp \
+	cc7/SecurePagePool.cpp \
+	cc7/ByteChain.cpp \
+	cc7/OwnedBytes.cpp \
+	cc7/MappedFile.cpp \
+	cc7/AllocationStats.cpp \
+	cc7/RecyclingPool.cpp \
+	cc7/Varint.cpp \
+	cc7/LargeByteArray.cpp \
+	cc7/WipeQuarantine.cpp \
+	cc7/Hash.cpp \
+	cc7/MutableByteRange.cpp \
+	cc7/Checksum.cpp \
+	cc7/DerReader.cpp \
+	cc7/ByteRangeSort.cpp
 
 # Android specific sources
 LOCAL_SRC_FILES += \
@@ -112,7 +127,25 @@ LOCAL_SRC_FILES += \
 	cc7tests/tests/cc7base/cc7ByteArrayTests.cpp \
 	cc7tests/tests/cc7base/cc7ByteRangeTests.cpp \
 	cc7tests/tests/cc7base/cc7HexStringTests.cpp \
-	cc7tests/tests/cc7base/cc7PlatformTests.cpp
+	cc7tests/tests/cc7base/cc7PlatformTests.cpp \
+	cc7tests/tests/cc7base/cc7SecureSmallByteArrayTests.cpp \
+	cc7tests/tests/cc7base/cc7SecurePagePoolTests.cpp \
+	cc7tests/tests/cc7base/cc7SharedBytesTests.cpp \
+	cc7tests/tests/cc7base/cc7ByteChainTests.cpp \
+	cc7tests/tests/cc7base/cc7AlignedByteArrayTests.cpp \
+	cc7tests/tests/cc7base/cc7OwnedBytesTests.cpp \
+	cc7tests/tests/cc7base/cc7MappedFileTests.cpp \
+	cc7tests/tests/cc7base/cc7AllocationStatsTests.cpp \
+	cc7tests/tests/cc7base/cc7RecyclingPoolTests.cpp \
+	cc7tests/tests/cc7base/cc7ByteReaderWriterTests.cpp \
+	cc7tests/tests/cc7base/cc7VarintTests.cpp \
+	cc7tests/tests/cc7base/cc7LargeByteArrayTests.cpp \
+	cc7tests/tests/cc7base/cc7WipeQuarantineTests.cpp \
+	cc7tests/tests/cc7base/cc7HashTests.cpp \
+	cc7tests/tests/cc7base/cc7MutableByteRangeTests.cpp \
+	cc7tests/tests/cc7base/cc7ChecksumTests.cpp \
+	cc7tests/tests/cc7base/cc7DerReaderTests.cpp \
+	cc7tests/tests/cc7base/cc7ByteRangeSortTests.cpp
 
 # Unit tests (OpenSSL)
 LOCAL_SRC_FILES += \
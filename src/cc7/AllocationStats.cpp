@@ -0,0 +1,285 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/AllocationStats.h>
+#include <string.h>
+
+#if defined(ENABLE_CC7_ALLOCATION_STATS)
+#include <atomic>
+#include <mutex>
+#endif
+
+namespace cc7
+{
+#if defined(ENABLE_CC7_ALLOCATION_STATS)
+
+namespace detail
+{
+    // -----------------------------------------------------------------
+    // Per-thread counters
+    // -----------------------------------------------------------------
+
+    enum StatsCounter
+    {
+        SC_Allocations,
+        SC_Deallocations,
+        SC_AllocatedBytes,
+        SC_DeallocatedBytes,
+        SC_WipedBytes,
+        SC_SecureClears,
+        SC_Reallocations,
+        SC_Histogram,
+        SC_Count = SC_Histogram + debug::AllocationStatistics::HISTOGRAM_SIZE
+    };
+
+    /**
+     The StatsShard contains counters for one thread. The counters are updated
+     only by the owning thread, so a plain load and store is enough. The atomic
+     type guarantees only that the snapshot reads a valid value.
+     */
+    struct StatsShard
+    {
+        std::atomic<U64>    counters[SC_Count];
+        StatsShard *        next;
+
+        StatsShard() : next(nullptr)
+        {
+            reset();
+        }
+
+        void add(size_t index, U64 value)
+        {
+            counters[index].store(counters[index].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void reset()
+        {
+            for (size_t i = 0; i < SC_Count; i++) {
+                counters[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /**
+     The StatsRegistry keeps the list of all shards and the counters from
+     already finished threads. The registry is never destroyed, because
+     the allocator can be used during the static objects destruction.
+     */
+    struct StatsRegistry
+    {
+        std::mutex          lock;
+        StatsShard *        shards;
+        StatsShard          retired;
+        std::atomic<U64>    live_bytes;
+        std::atomic<U64>    peak_live_bytes;
+
+        StatsRegistry() :
+            shards(nullptr),
+            live_bytes(0),
+            peak_live_bytes(0)
+        {
+        }
+
+        static StatsRegistry & instance()
+        {
+            static StatsRegistry * s_registry = new StatsRegistry();
+            return *s_registry;
+        }
+
+        void addShard(StatsShard * shard)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            shard->next = shards;
+            shards = shard;
+        }
+
+        void retireShard(StatsShard * shard)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (size_t i = 0; i < SC_Count; i++) {
+                retired.add(i, shard->counters[i].load(std::memory_order_relaxed));
+            }
+            StatsShard ** pp = &shards;
+            while (*pp) {
+                if (*pp == shard) {
+                    *pp = shard->next;
+                    break;
+                }
+                pp = &(*pp)->next;
+            }
+        }
+    };
+
+    /**
+     Set to true once the thread's shard is destroyed. Other thread-local
+     objects may still release their memory after that point.
+     */
+    static thread_local bool s_thread_finished = false;
+
+    /**
+     The ThreadShard registers the thread's shard at first use and moves
+     its counters to the registry when the thread finishes.
+     */
+    struct ThreadShard
+    {
+        StatsShard shard;
+
+        ThreadShard()
+        {
+            StatsRegistry::instance().addShard(&shard);
+        }
+
+        ~ThreadShard()
+        {
+            s_thread_finished = true;
+            StatsRegistry::instance().retireShard(&shard);
+        }
+    };
+
+    static inline void _Record(size_t index, U64 value)
+    {
+        if (!s_thread_finished) {
+            static thread_local ThreadShard s_thread_shard;
+            s_thread_shard.shard.add(index, value);
+        } else {
+            // Late deallocation, after the thread's shard has been destroyed.
+            StatsRegistry & registry = StatsRegistry::instance();
+            std::lock_guard<std::mutex> guard(registry.lock);
+            registry.retired.add(index, value);
+        }
+    }
+
+    static inline size_t _HistogramIndex(size_t size)
+    {
+        size_t index = 0;
+        size_t limit = 16;
+        while (size > limit && index < debug::AllocationStatistics::HISTOGRAM_SIZE - 1) {
+            limit <<= 1;
+            index++;
+        }
+        return index;
+    }
+
+    // -----------------------------------------------------------------
+    // Hooks
+    // -----------------------------------------------------------------
+
+    void AllocationStats_OnAllocate(size_t size)
+    {
+        _Record(SC_Allocations, 1);
+        _Record(SC_AllocatedBytes, size);
+        _Record(SC_Histogram + _HistogramIndex(size), 1);
+
+        StatsRegistry & registry = StatsRegistry::instance();
+        U64 live = registry.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        U64 peak = registry.peak_live_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !registry.peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            // peak has been updated by compare_exchange_weak(), try again
+        }
+    }
+
+    void AllocationStats_OnDeallocate(size_t size)
+    {
+        _Record(SC_Deallocations, 1);
+        _Record(SC_DeallocatedBytes, size);
+        StatsRegistry::instance().live_bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void AllocationStats_OnWipe(size_t size, bool secure_clear)
+    {
+        _Record(SC_WipedBytes, size);
+        if (secure_clear) {
+            _Record(SC_SecureClears, 1);
+        }
+    }
+
+    void AllocationStats_OnReallocation()
+    {
+        _Record(SC_Reallocations, 1);
+    }
+
+} // cc7::detail
+
+#endif // defined(ENABLE_CC7_ALLOCATION_STATS)
+
+namespace debug
+{
+    // -----------------------------------------------------------------
+    // Public interface
+    // -----------------------------------------------------------------
+
+    const size_t AllocationStatistics::HISTOGRAM_SIZE;
+
+    bool HasAllocationStatistics()
+    {
+#if defined(ENABLE_CC7_ALLOCATION_STATS)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    AllocationStatistics GetAllocationStatistics()
+    {
+        AllocationStatistics result;
+        memset(&result, 0, sizeof(result));
+#if defined(ENABLE_CC7_ALLOCATION_STATS)
+        using namespace detail;
+        U64 totals[SC_Count];
+        StatsRegistry & registry = StatsRegistry::instance();
+        {
+            std::lock_guard<std::mutex> guard(registry.lock);
+            for (size_t i = 0; i < SC_Count; i++) {
+                totals[i] = registry.retired.counters[i].load(std::memory_order_relaxed);
+            }
+            for (StatsShard * shard = registry.shards; shard; shard = shard->next) {
+                for (size_t i = 0; i < SC_Count; i++) {
+                    totals[i] += shard->counters[i].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        result.allocations          = totals[SC_Allocations];
+        result.deallocations        = totals[SC_Deallocations];
+        result.allocated_bytes      = totals[SC_AllocatedBytes];
+        result.deallocated_bytes    = totals[SC_DeallocatedBytes];
+        result.wiped_bytes          = totals[SC_WipedBytes];
+        result.secure_clears        = totals[SC_SecureClears];
+        result.reallocations        = totals[SC_Reallocations];
+        for (size_t i = 0; i < AllocationStatistics::HISTOGRAM_SIZE; i++) {
+            result.size_histogram[i] = totals[SC_Histogram + i];
+        }
+        result.live_bytes           = registry.live_bytes.load(std::memory_order_relaxed);
+        result.peak_live_bytes      = registry.peak_live_bytes.load(std::memory_order_relaxed);
+#endif
+        return result;
+    }
+
+    void ResetAllocationStatistics()
+    {
+#if defined(ENABLE_CC7_ALLOCATION_STATS)
+        using namespace detail;
+        StatsRegistry & registry = StatsRegistry::instance();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        registry.retired.reset();
+        for (StatsShard * shard = registry.shards; shard; shard = shard->next) {
+            shard->reset();
+        }
+        registry.peak_live_bytes.store(registry.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+#endif
+    }
+
+} // cc7::debug
+} // cc7
@@ -15,6 +15,9 @@
  */
 
 #include <cc7/Base32.h>
+#include <cc7/ByteChain.h>
+#include <tuple>
+#include <algorithm>
 
 namespace cc7
 {
@@ -52,13 +55,10 @@ namespace cc7
     static const char s_padding = '=';
     
     /*
-     The main encode function.
+     The main encode function. Appends encoded |bytes| to the |out_string|.
      */
-    bool Base32_Encode(const ByteRange & bytes, bool use_padding, std::string & out_string)
+    static void _Base32_Append(const ByteRange & bytes, bool use_padding, std::string & out_string)
     {
-        out_string.clear();
-        out_string.reserve((bytes.length() * 8 + 4) / 5);
-        
         size_t index = 0, append = 0;
         U16 curr_byte, digit;
         char buffer[8];
@@ -120,6 +120,47 @@ namespace cc7
                 out_string.append(8 - append, s_padding);
             }
         }
+    }
+    
+    bool Base32_Encode(const ByteRange & bytes, bool use_padding, std::string & out_string)
+    {
+        out_string.clear();
+        out_string.reserve((bytes.length() * 8 + 4) / 5);
+        _Base32_Append(bytes, use_padding, out_string);
+        return true;
+    }
+    
+    bool Base32_Encode(const ByteChain & chain, bool use_padding, std::string & out_string)
+    {
+        out_string.clear();
+        out_string.reserve((chain.size() * 8 + 4) / 5);
+        
+        // Only complete 5 byte blocks are encoded from the segments. Up to 4 bytes
+        // of an incomplete block are kept for the next segment.
+        byte pending[5];
+        size_t pending_count = 0;
+        for (auto && segment : chain) {
+            ByteRange range = segment;
+            if (pending_count > 0) {
+                const size_t count = std::min(5 - pending_count, range.size());
+                memcpy(pending + pending_count, range.data(), count);
+                pending_count += count;
+                range.removePrefix(count);
+                if (pending_count < 5) {
+                    continue;
+                }
+                _Base32_Append(ByteRange(pending, 5), use_padding, out_string);
+                pending_count = 0;
+            }
+            const size_t aligned = range.size() - range.size() % 5;
+            _Base32_Append(range.subRangeTo(aligned), use_padding, out_string);
+            pending_count = range.size() - aligned;
+            if (pending_count > 0) {
+                memcpy(pending, range.data() + aligned, pending_count);
+            }
+        }
+        _Base32_Append(ByteRange(pending, pending_count), use_padding, out_string);
+        CC7_SecureClean(pending, sizeof(pending));
         return true;
     }
     
@@ -300,4 +341,16 @@ namespace cc7
         return true;
     }
     
+    bool Base32_Decode(const std::string & in_string, bool require_padding, ByteChain & out_chain)
+    {
+        ByteArray data;
+        if (!Base32_Decode(in_string, require_padding, data)) {
+            return false;
+        }
+        if (!data.empty()) {
+            out_chain.append(std::move(data));
+        }
+        return true;
+    }
+    
 } // cc7
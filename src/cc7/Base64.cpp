@@ -15,6 +15,8 @@
  */
 
 #include <cc7/Base64.h>
+#include <cc7/ByteChain.h>
+#include <cc7/MutableByteRange.h>
 #include <cc7/Utilities.h>
 
 namespace cc7
@@ -38,51 +40,142 @@ namespace cc7
         return n;
     }
 
-    bool Base64_Encode(const ByteRange & range, size_t wrap_size, std::string & out_string)
+namespace
+{
+    /**
+     The Base64Encoder is a streaming encoder, which can process input data split
+     into multiple segments. The encoder keeps up to 2 bytes of an incomplete triplet
+     and the current position in line between the segments.
+     */
+    class Base64Encoder
     {
-        out_string.clear();
+    public:
+        Base64Encoder(size_t wrap_size, std::string & out_string) :
+            _out(out_string),
+            _wrap_size(wrap_size),
+            _wrap_pos(0),
+            _pending_count(0)
+        {
+        }
         
-        if (wrap_size > 0) {
-            if (utilities::AlignValue<4>(wrap_size) != wrap_size) {
-                CC7_ASSERT(false, "wrap_size must be divisible by 4");
-                return false;
+        ~Base64Encoder()
+        {
+            CC7_SecureClean(_pending, sizeof(_pending));
+        }
+        
+        void update(const ByteRange & range)
+        {
+            const byte * in_p   = range.data();
+            size_t in_len       = range.size();
+            
+            if (_pending_count > 0) {
+                // Complete the triplet from the previous segment
+                while (_pending_count < 3 && in_len > 0) {
+                    _pending[_pending_count++] = *in_p++;
+                    in_len--;
+                }
+                if (_pending_count < 3) {
+                    return;
+                }
+                encodeTriplet(_pending);
+                _pending_count = 0;
+            }
+            while (in_len >= 3) {
+                // Process all aligned triplets
+                encodeTriplet(in_p);
+                in_len -= 3;
+                in_p   += 3;
+            }
+            while (in_len > 0) {
+                // Keep the rest for the next segment
+                _pending[_pending_count++] = *in_p++;
+                in_len--;
             }
         }
         
-        out_string.reserve(_EstimateEncodedLength(range.size(), wrap_size));
+        void finish()
+        {
+            if (_pending_count > 0) {
+                // Process the rest of unaligned bytes
+                const byte * in_p = _pending;
+                size_t in_len = _pending_count;
+                char block_4[4];
+                block_4[0] = s_enc_table[  (in_p[0] >> 2) & 0x3f ];
+                block_4[1] = s_enc_table[ ((in_p[0] << 4) + (--in_len ? in_p[1] >> 4 : 0)) & 0x3f ];
+                block_4[2] = (in_len ? s_enc_table[ ((in_p[1] << 2) + (--in_len ? (in_p[2]) >> 6 : 0)) & 0x3f ] : '=');
+                block_4[3] = '=';
+                _out.append(block_4, 4);
+                _pending_count = 0;
+            }
+        }
         
-        char block_4[4];
-        const byte * in_p   = range.data();
-        size_t in_len       = range.size();
-        size_t wrap_pos     = 0;
+    private:
         
-        while (in_len >= 3) {
-            // Process all aligned triplets
+        void encodeTriplet(const byte * in_p)
+        {
+            char block_4[4];
             block_4[0] = s_enc_table[  (in_p[0] & 0xfc) >> 2                            ];
             block_4[1] = s_enc_table[ ((in_p[0] & 0x03) << 4) + ((in_p[1] & 0xf0) >> 4) ];
             block_4[2] = s_enc_table[ ((in_p[1] & 0x0f) << 2) + ((in_p[2] & 0xc0) >> 6) ];
             block_4[3] = s_enc_table[   in_p[2] & 0x3f                                  ];
-            in_len -= 3;
-            in_p   += 3;
-            out_string.append(block_4, 4);
-            if (wrap_size) {
-                wrap_pos += 4;
-                if (wrap_pos >= wrap_size) {
-                    out_string.append("\n");
-                    wrap_pos = 0;
+            _out.append(block_4, 4);
+            if (_wrap_size) {
+                _wrap_pos += 4;
+                if (_wrap_pos >= _wrap_size) {
+                    _out.append("\n");
+                    _wrap_pos = 0;
                 }
             }
         }
-        if (in_len > 0) {
-            // Process the rest of unaligned bytes
-            block_4[0] = s_enc_table[  (in_p[0] >> 2) & 0x3f ];
-            block_4[1] = s_enc_table[ ((in_p[0] << 4) + (--in_len ? in_p[1] >> 4 : 0)) & 0x3f ];
-            block_4[2] = (in_len ? s_enc_table[ ((in_p[1] << 2) + (--in_len ? (in_p[2]) >> 6 : 0)) & 0x3f ] : '=');
-            block_4[3] = '=';
-            out_string.append(block_4, 4);
+        
+        std::string &   _out;
+        size_t          _wrap_size;
+        size_t          _wrap_pos;
+        byte            _pending[3];
+        size_t          _pending_count;
+    };
+} // anonymous namespace
+    
+    static bool _ValidateWrapSize(size_t wrap_size)
+    {
+        if (wrap_size > 0) {
+            if (utilities::AlignValue<4>(wrap_size) != wrap_size) {
+                CC7_ASSERT(false, "wrap_size must be divisible by 4");
+                return false;
+            }
         }
         return true;
     }
+
+    bool Base64_Encode(const ByteRange & range, size_t wrap_size, std::string & out_string)
+    {
+        out_string.clear();
+        if (!_ValidateWrapSize(wrap_size)) {
+            return false;
+        }
+        out_string.reserve(_EstimateEncodedLength(range.size(), wrap_size));
+        
+        Base64Encoder encoder(wrap_size, out_string);
+        encoder.update(range);
+        encoder.finish();
+        return true;
+    }
+    
+    bool Base64_Encode(const ByteChain & chain, size_t wrap_size, std::string & out_string)
+    {
+        out_string.clear();
+        if (!_ValidateWrapSize(wrap_size)) {
+            return false;
+        }
+        out_string.reserve(_EstimateEncodedLength(chain.size(), wrap_size));
+        
+        Base64Encoder encoder(wrap_size, out_string);
+        for (auto && segment : chain) {
+            encoder.update(segment);
+        }
+        encoder.finish();
+        return true;
+    }
     
     
     // MARK: Decoder -
@@ -111,8 +204,65 @@ namespace cc7
         0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
     };
     
+namespace
+{
+    /**
+     The DecoderOutput provides memory for the decoded bytes. The bytes are
+     appended either to ByteArray, or to a fixed buffer provided by the caller.
+     */
+    class DecoderOutput
+    {
+    public:
+        DecoderOutput(ByteArray & array) :
+            _array(&array),
+            _buffer(nullptr),
+            _capacity(0),
+            _size(0)
+        {
+        }
+        
+        DecoderOutput(byte * buffer, size_t capacity) :
+            _array(nullptr),
+            _buffer(buffer),
+            _capacity(capacity),
+            _size(0)
+        {
+        }
+        
+        /**
+         Returns pointer to |n| new bytes at the end of the output, or nullptr
+         if the fixed buffer is too small.
+         */
+        byte * grow(size_t n)
+        {
+            if (_array) {
+                const size_t offset = _array->size();
+                _array->resizeUninitialized(offset + n);
+                return _array->data() + offset;
+            }
+            if (n > _capacity - _size) {
+                return nullptr;
+            }
+            byte * p = _buffer + _size;
+            _size += n;
+            return p;
+        }
+        
+        size_t size() const
+        {
+            return _array ? _array->size() : _size;
+        }
+        
+    private:
+        ByteArray * _array;
+        byte *      _buffer;
+        size_t      _capacity;
+        size_t      _size;
+    };
+} // anonymous namespace
+    
     static bool Base64_DecodeNoWrap(const std::string & str, size_t sequence_start, size_t sequence_length,
-                                    ByteArray & out_data,
+                                    DecoderOutput & out_data,
                                     bool & end_marker)
     {
         if (sequence_length == 0) {
@@ -133,19 +283,24 @@ namespace cc7
             return false;
         }
         
-        //
-        // Reserve bytes in the byte array. The produced_size is a worst case
-        // estimation for length of final data.
-        //
-        size_t blocks_count  = sequence_length / 4;
-        size_t block_size    = blocks_count * 3;
-        out_data.reserve(out_data.size() + block_size);
-        
         // Input pointer
         const byte * block_4 = reinterpret_cast<const byte*>(str.c_str()) + sequence_start;
         
         // Check if last block contains padding and thus requires additional processing.
-        end_marker = block_4[sequence_length - 1] == '=' || block_4[sequence_length - 2] == '=';
+        const size_t padding = (block_4[sequence_length - 1] == '=') + (block_4[sequence_length - 2] == '=');
+        end_marker = padding > 0;
+        
+        //
+        // Reserve bytes in the output. Each padding character reduces the size
+        // of the last block by one byte, so the reserved size is exact.
+        //
+        size_t blocks_count  = sequence_length / 4;
+        size_t block_size    = blocks_count * 3 - padding;
+        byte * out_p = out_data.grow(block_size);
+        if (!out_p) {
+            // The output buffer is too small.
+            return false;
+        }
         if (end_marker) {
             // Decrease number of "fast" blocks. We will process last one in a separate branch.
             blocks_count--;
@@ -166,9 +321,10 @@ namespace cc7
                 return false;
             }
             
-            out_data.push_back((c[0] << 2) | (c[1] >> 4));
-            out_data.push_back((c[1] << 4) | (c[2] >> 2));
-            out_data.push_back((c[2] << 6) |  c[3]);
+            out_p[0] = (c[0] << 2) | (c[1] >> 4);
+            out_p[1] = (c[1] << 4) | (c[2] >> 2);
+            out_p[2] = (c[2] << 6) |  c[3];
+            out_p += 3;
             
             blocks_count--;
             block_4 += 4;
@@ -183,7 +339,7 @@ namespace cc7
                 return false;
             }
             // First byte should be always decoded
-            out_data.push_back((c[0] << 2) | (c[1] >> 4));
+            *out_p++ = (c[0] << 2) | (c[1] >> 4);
             
             if (block_4[2] == '=') {
                 // Last two characters should be padding markers
@@ -202,7 +358,7 @@ namespace cc7
                     return false;
                 }
                 // c3 is correct and last character is padding
-                out_data.push_back((c[1] << 4) | (c[2] >> 2));
+                *out_p++ = (c[1] << 4) | (c[2] >> 2);
             } else {
                 // This migh never happen. The 'end_marker' claims that the sequence
                 // contains padding marker, but the deep inspection is telling something else.
@@ -214,29 +370,13 @@ namespace cc7
         return true;
     }
     
-    bool Base64_Decode(const std::string & string, size_t wrap_size, ByteArray & out_data)
+    static bool Base64_DecodeToOutput(const std::string & string, size_t wrap_size, DecoderOutput & out_data)
     {
         bool result = false;
-        out_data.clear();
         if (wrap_size > 0) {
             //
             // wrap impl.
             //
-            if (utilities::AlignValue<4>(wrap_size) != wrap_size) {
-                CC7_ASSERT(false, "wrap_size must be divisible by 4");
-                return false;
-            }
-
-            // Calculate estimated data size (just to eliminate multiple reallocations in the data buffer)
-            size_t size = string.size();
-            size_t div = size / (wrap_size + 1);
-            size_t rem = size % (wrap_size + 1);
-            // subtract a number of possible new line characters
-            size -= div + (rem > 0 ? 1 : 0);
-            // final expected size of data
-            size_t byte_size = ((size + 3) / 4) * 3;
-            out_data.reserve(byte_size);
-            
             // Current & End pointer
             const char * str_p   = string.c_str();
             const char * str_end = string.c_str() + string.length();
@@ -267,7 +407,6 @@ namespace cc7
                     // There's some sequence of non-space characters.
                     if (end_marker) {
                         // previous line did end with end-marker. If there's a next line, then this is an error.
-                        out_data.clear();
                         return false;
                     }
                     // The rest of the decoding is handled in the "NoWrap" routine.
@@ -282,10 +421,58 @@ namespace cc7
             bool foo;
             result = Base64_DecodeNoWrap(string, 0, string.length(), out_data, foo);
         }
-        if (!result) {
+        return result;
+    }
+    
+    bool Base64_Decode(const std::string & string, size_t wrap_size, ByteArray & out_data)
+    {
+        out_data.clear();
+        if (!_ValidateWrapSize(wrap_size)) {
+            return false;
+        }
+        if (wrap_size > 0) {
+            // Calculate estimated data size (just to eliminate multiple reallocations in the data buffer)
+            size_t size = string.size();
+            size_t div = size / (wrap_size + 1);
+            size_t rem = size % (wrap_size + 1);
+            // subtract a number of possible new line characters
+            size -= div + (rem > 0 ? 1 : 0);
+            // final expected size of data
+            size_t byte_size = ((size + 3) / 4) * 3;
+            out_data.reserve(byte_size);
+        }
+        DecoderOutput output(out_data);
+        if (!Base64_DecodeToOutput(string, wrap_size, output)) {
             out_data.clear();
+            return false;
         }
-        return result;
+        return true;
+    }
+    
+    bool Base64_Decode(const std::string & in_string, size_t wrap_size, MutableByteRange out_buffer, size_t & out_size)
+    {
+        out_size = 0;
+        if (!_ValidateWrapSize(wrap_size)) {
+            return false;
+        }
+        DecoderOutput output(out_buffer.data(), out_buffer.size());
+        if (!Base64_DecodeToOutput(in_string, wrap_size, output)) {
+            return false;
+        }
+        out_size = output.size();
+        return true;
+    }
+    
+    bool Base64_Decode(const std::string & in_string, size_t wrap_size, ByteChain & out_chain)
+    {
+        ByteArray data;
+        if (!Base64_Decode(in_string, wrap_size, data)) {
+            return false;
+        }
+        if (!data.empty()) {
+            out_chain.append(std::move(data));
+        }
+        return true;
     }
 
 } // cc7
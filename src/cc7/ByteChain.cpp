@@ -0,0 +1,286 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/ByteChain.h>
+
+namespace cc7
+{
+    // MARK: - Private helpers -
+
+    void ByteChain::_pushBack(const SharedBytes & owner, const ByteRange & range)
+    {
+        if (!range.empty()) {
+            Segment segment = { owner, range };
+            _segments.push_back(std::move(segment));
+            _size += range.size();
+        }
+    }
+
+    void ByteChain::_pushFront(const SharedBytes & owner, const ByteRange & range)
+    {
+        if (!range.empty()) {
+            Segment segment = { owner, range };
+            _segments.push_front(std::move(segment));
+            _size += range.size();
+        }
+    }
+
+    ByteChain::size_type ByteChain::_splitAt(size_type position)
+    {
+        CC7_ASSERT(position <= _size, "Position is out of range");
+        size_type index = 0;
+        while (index < _segments.size()) {
+            Segment & segment = _segments[index];
+            const size_type segment_size = segment.range.size();
+            if (position == 0) {
+                break;
+            }
+            if (position < segment_size) {
+                // Split the segment into two. Both parts share the owner.
+                Segment tail = { segment.owner, segment.range.subRangeFrom(position) };
+                segment.range = segment.range.subRangeTo(position);
+                _segments.insert(_segments.begin() + index + 1, std::move(tail));
+                return index + 1;
+            }
+            position -= segment_size;
+            index++;
+        }
+        return index;
+    }
+
+    // MARK: - Append & Prepend -
+
+    ByteChain & ByteChain::append(ByteArray && array)
+    {
+        if (!array.empty()) {
+            SharedBytes owner(std::move(array));
+            _pushBack(owner, owner.byteRange());
+        }
+        return *this;
+    }
+
+    ByteChain & ByteChain::append(const SharedBytes & bytes)
+    {
+        _pushBack(bytes, bytes.byteRange());
+        return *this;
+    }
+
+    ByteChain & ByteChain::append(const ByteChain & chain)
+    {
+        if (&chain == this) {
+            // Appending to itself. Make a copy of the segment list first.
+            ByteChain copy(chain);
+            return append(copy);
+        }
+        for (auto && segment : chain._segments) {
+            _pushBack(segment.owner, segment.range);
+        }
+        return *this;
+    }
+
+    ByteChain & ByteChain::appendBorrowed(const ByteRange & range)
+    {
+        _pushBack(SharedBytes(), range);
+        return *this;
+    }
+
+    ByteChain & ByteChain::prepend(ByteArray && array)
+    {
+        if (!array.empty()) {
+            SharedBytes owner(std::move(array));
+            _pushFront(owner, owner.byteRange());
+        }
+        return *this;
+    }
+
+    ByteChain & ByteChain::prepend(const SharedBytes & bytes)
+    {
+        _pushFront(bytes, bytes.byteRange());
+        return *this;
+    }
+
+    ByteChain & ByteChain::prepend(const ByteChain & chain)
+    {
+        if (&chain == this) {
+            ByteChain copy(chain);
+            return prepend(copy);
+        }
+        for (auto it = chain._segments.rbegin(); it != chain._segments.rend(); ++it) {
+            _pushFront(it->owner, it->range);
+        }
+        return *this;
+    }
+
+    ByteChain & ByteChain::prependBorrowed(const ByteRange & range)
+    {
+        _pushFront(SharedBytes(), range);
+        return *this;
+    }
+
+    // MARK: - Splice & Remove -
+
+    ByteChain & ByteChain::splice(size_type position, const ByteChain & chain)
+    {
+        if (position > _size) {
+            _ByteChainExceptions::out_of_range();
+            return *this;
+        }
+        if (&chain == this) {
+            ByteChain copy(chain);
+            return splice(position, copy);
+        }
+        if (chain.empty()) {
+            return *this;
+        }
+        const size_type index = _splitAt(position);
+        _segments.insert(_segments.begin() + index, chain._segments.begin(), chain._segments.end());
+        _size += chain._size;
+        return *this;
+    }
+
+    void ByteChain::removePrefix(size_type count)
+    {
+        if (count > _size) {
+            _ByteChainExceptions::out_of_range();
+            return;
+        }
+        _size -= count;
+        while (count > 0) {
+            Segment & front = _segments.front();
+            const size_type segment_size = front.range.size();
+            if (count < segment_size) {
+                front.range.removePrefix(count);
+                break;
+            }
+            count -= segment_size;
+            _segments.pop_front();
+        }
+    }
+
+    void ByteChain::removeSuffix(size_type count)
+    {
+        if (count > _size) {
+            _ByteChainExceptions::out_of_range();
+            return;
+        }
+        _size -= count;
+        while (count > 0) {
+            Segment & back = _segments.back();
+            const size_type segment_size = back.range.size();
+            if (count < segment_size) {
+                back.range.removeSuffix(count);
+                break;
+            }
+            count -= segment_size;
+            _segments.pop_back();
+        }
+    }
+
+    void ByteChain::clear()
+    {
+        _segments.clear();
+        _size = 0;
+    }
+
+    // MARK: - Conversions -
+
+    ByteArray ByteChain::flatten() const
+    {
+        ByteArray result;
+        result.reserve(_size);
+        for (auto && segment : _segments) {
+            result.append(segment.range);
+        }
+        return result;
+    }
+
+    ByteChain ByteChain::subChain(size_type from, size_type count) const
+    {
+        ByteChain result;
+        if ((from > _size) || (count > _size - from)) {
+            _ByteChainExceptions::out_of_range();
+            return result;
+        }
+        for (auto && segment : _segments) {
+            if (count == 0) {
+                break;
+            }
+            const size_type segment_size = segment.range.size();
+            if (from >= segment_size) {
+                from -= segment_size;
+                continue;
+            }
+            const size_type n = std::min(count, segment_size - from);
+            result._pushBack(segment.owner, segment.range.subRange(from, n));
+            count -= n;
+            from = 0;
+        }
+        return result;
+    }
+
+#if !defined(CC7_WINDOWS)
+
+    ByteChain::size_type ByteChain::exportIOVec(struct iovec * iov, size_type max_count, size_type first_segment) const
+    {
+        size_type count = 0;
+        for (size_type index = first_segment; index < _segments.size() && count < max_count; index++) {
+            const ByteRange & range = _segments[index].range;
+            iov[count].iov_base = const_cast<cc7::byte*>(range.data());
+            iov[count].iov_len  = range.size();
+            count++;
+        }
+        return count;
+    }
+
+    std::vector<struct iovec> ByteChain::ioVectors() const
+    {
+        std::vector<struct iovec> result(_segments.size());
+        if (!result.empty()) {
+            exportIOVec(result.data(), result.size());
+        }
+        return result;
+    }
+
+    ByteChain::size_type ByteChain::prepareReceive(struct iovec * iov, size_type count, size_type segment_size)
+    {
+        if (segment_size == 0) {
+            return 0;
+        }
+        for (size_type i = 0; i < count; i++) {
+            ByteArray buffer;
+            buffer.resizeUninitialized(segment_size);
+            SharedBytes owner(std::move(buffer));
+            // The buffer has just been created, so this chain is its only owner
+            // and the bytes can be written until the receive is committed.
+            iov[i].iov_base = const_cast<cc7::byte*>(owner.data());
+            iov[i].iov_len  = segment_size;
+            _pushBack(owner, owner.byteRange());
+        }
+        return count * segment_size;
+    }
+
+    void ByteChain::commitReceive(size_type prepared_size, size_type received)
+    {
+        if (received > prepared_size) {
+            _ByteChainExceptions::out_of_range();
+            return;
+        }
+        removeSuffix(prepared_size - received);
+    }
+
+#endif // !defined(CC7_WINDOWS)
+
+} // cc7
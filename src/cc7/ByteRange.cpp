@@ -17,6 +17,26 @@
 #include <cc7/ByteRange.h>
 #include <cc7/Base64.h>
 #include <cc7/HexString.h>
+#include <cc7/Utilities.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define CC7_BYTERANGE_USE_SSE2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define CC7_BYTERANGE_USE_NEON
+#endif
+
+// The barrier hides the accumulator's value from the optimizer, so the compiler
+// can't turn the constant-time loop into a loop with an early exit.
+#if defined(__GNUC__) || defined(__clang__)
+    #define CC7_VALUE_BARRIER(value)    __asm__ __volatile__("" : "+r"(value))
+    #define CC7_VECTOR_BARRIER(value)   __asm__ __volatile__("" : "+x"(value))
+#else
+    #define CC7_VALUE_BARRIER(value)
+    #define CC7_VECTOR_BARRIER(value)
+#endif
 
 namespace cc7
 {
@@ -33,5 +53,208 @@ namespace cc7
         HexString_Encode(*this, lower_case, result);
         return result;
     }
+    
+    // -----------------------------------------------------------------
+    // Constant time comparison
+    // -----------------------------------------------------------------
+    
+    bool EqualsConstantTime(const ByteRange & x, const ByteRange & y) noexcept
+    {
+        if (x.size() != y.size()) {
+            return false;
+        }
+        const cc7::byte * px = x.data();
+        const cc7::byte * py = y.data();
+        size_t size = x.size();
+        // All differences are accumulated with OR, there's no branch depending on the data.
+        U64 diff = 0;
+    #if defined(CC7_BYTERANGE_USE_SSE2)
+        if (size >= 32) {
+            __m128i acc0 = _mm_setzero_si128();
+            __m128i acc1 = _mm_setzero_si128();
+            do {
+                const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+                const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + 16));
+                const __m128i y0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(py));
+                const __m128i y1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(py + 16));
+                acc0 = _mm_or_si128(acc0, _mm_xor_si128(x0, y0));
+                acc1 = _mm_or_si128(acc1, _mm_xor_si128(x1, y1));
+                CC7_VECTOR_BARRIER(acc0);
+                px += 32;
+                py += 32;
+                size -= 32;
+            } while (size >= 32);
+            acc0 = _mm_or_si128(acc0, acc1);
+            acc0 = _mm_or_si128(acc0, _mm_unpackhi_epi64(acc0, acc0));
+            U64 lanes[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc0);
+            diff |= lanes[0];
+        }
+    #elif defined(CC7_BYTERANGE_USE_NEON)
+        if (size >= 32) {
+            uint8x16_t acc0 = vdupq_n_u8(0);
+            uint8x16_t acc1 = vdupq_n_u8(0);
+            do {
+                acc0 = vorrq_u8(acc0, veorq_u8(vld1q_u8(px), vld1q_u8(py)));
+                acc1 = vorrq_u8(acc1, veorq_u8(vld1q_u8(px + 16), vld1q_u8(py + 16)));
+                px += 32;
+                py += 32;
+                size -= 32;
+            } while (size >= 32);
+            const uint64x2_t acc = vreinterpretq_u64_u8(vorrq_u8(acc0, acc1));
+            diff |= vgetq_lane_u64(acc, 0) | vgetq_lane_u64(acc, 1);
+        }
+    #endif
+        while (size >= 8) {
+            U64 wx, wy;
+            memcpy(&wx, px, 8);
+            memcpy(&wy, py, 8);
+            diff |= wx ^ wy;
+            CC7_VALUE_BARRIER(diff);
+            px += 8;
+            py += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            diff |= *px++ ^ *py++;
+            CC7_VALUE_BARRIER(diff);
+            size--;
+        }
+        // Convert to bool without a branch. The highest bit of (diff | -diff)
+        // is set only when diff is not zero.
+        return (((diff | (0 - diff)) >> 63) ^ 1) != 0;
+    }
+    
+    bool ByteRange::equalsConstantTime(const ByteRange & other) const noexcept
+    {
+        return EqualsConstantTime(*this, other);
+    }
+    
+    // -----------------------------------------------------------------
+    // Searching
+    // -----------------------------------------------------------------
+    
+    /**
+     Returns position of |needle| in |haystack|, or nullptr if not found. The needle
+     must be at least 2 bytes long and not longer than the haystack.
+     */
+    static const byte * _FindSubsequence(const byte * haystack, size_t haystack_size, const byte * needle, size_t needle_size)
+    {
+        const byte first = needle[0];
+        const byte last  = needle[needle_size - 1];
+        const size_t last_pos = haystack_size - needle_size;    // The last possible position of the needle
+        size_t i = 0;
+        
+    #if defined(CC7_BYTERANGE_USE_SSE2)
+        // Compare the first and the last byte of the needle at 16 positions at once,
+        // and then verify only the positions where both bytes match.
+        const __m128i first_v = _mm_set1_epi8(static_cast<char>(first));
+        const __m128i last_v  = _mm_set1_epi8(static_cast<char>(last));
+        while (i + 15 <= last_pos) {
+            const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+            const __m128i block_last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needle_size - 1));
+            U32 mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first_v), _mm_cmpeq_epi8(block_last, last_v)));
+            while (mask != 0) {
+                const size_t offset = i + utilities::CountTrailingZeros(mask);
+                if (memcmp(haystack + offset + 1, needle + 1, needle_size - 2) == 0) {
+                    return haystack + offset;
+                }
+                mask &= mask - 1;
+            }
+            i += 16;
+        }
+    #endif
+        // Use memchr() to skip to the next candidate for the first byte.
+        while (i <= last_pos) {
+            const byte * candidate = static_cast<const byte*>(memchr(haystack + i, first, last_pos - i + 1));
+            if (!candidate) {
+                break;
+            }
+            if (candidate[needle_size - 1] == last && memcmp(candidate + 1, needle + 1, needle_size - 2) == 0) {
+                return candidate;
+            }
+            i = candidate - haystack + 1;
+        }
+        return nullptr;
+    }
+    
+    ByteRange::size_type ByteRange::find(const ByteRange & needle, size_type pos) const noexcept
+    {
+        const size_type needle_size = needle.size();
+        if (pos > size() || needle_size > size() - pos) {
+            return npos;
+        }
+        if (needle_size <= 1) {
+            return needle_size == 0 ? pos : find(needle[0], pos);
+        }
+        const byte * found = _FindSubsequence(_begin + pos, size() - pos, needle.data(), needle_size);
+        return found ? found - _begin : npos;
+    }
+    
+    ByteRange::size_type ByteRange::rfind(value_type b, size_type pos) const noexcept
+    {
+        if (empty()) {
+            return npos;
+        }
+        size_type count = pos < size() ? pos + 1 : size();
+    #if defined(__GLIBC__)
+        const void * found = memrchr(_begin, b, count);
+        return found ? static_cast<const_pointer>(found) - _begin : npos;
+    #else
+        while (count > 0) {
+            if (_begin[--count] == b) {
+                return count;
+            }
+        }
+        return npos;
+    #endif
+    }
+    
+    ByteRange::size_type ByteRange::rfind(const ByteRange & needle, size_type pos) const noexcept
+    {
+        const size_type needle_size = needle.size();
+        if (needle_size > size()) {
+            return npos;
+        }
+        size_type start = std::min(pos, size() - needle_size);
+        if (needle_size == 0) {
+            return start;
+        }
+        // Look for the first byte backwards, then compare the rest.
+        while (true) {
+            start = rfind(needle[0], start);
+            if (start == npos) {
+                return npos;
+            }
+            if (memcmp(_begin + start + 1, needle.data() + 1, needle_size - 1) == 0) {
+                return start;
+            }
+            if (start == 0) {
+                return npos;
+            }
+            start--;
+        }
+    }
+    
+    ByteRange::size_type ByteRange::find_first_of(const ByteRange & set, size_type pos) const noexcept
+    {
+        if (pos >= size() || set.empty()) {
+            return npos;
+        }
+        if (set.size() == 1) {
+            return find(set[0], pos);
+        }
+        // Build a 256-bit lookup table from the set.
+        U32 table[8] = { 0 };
+        for (byte b : set) {
+            table[b >> 5] |= 1U << (b & 31);
+        }
+        for (const_pointer p = _begin + pos; p < _end; p++) {
+            if (table[*p >> 5] & (1U << (*p & 31))) {
+                return p - _begin;
+            }
+        }
+        return npos;
+    }
 
 } // cc7
\ No newline at end of file
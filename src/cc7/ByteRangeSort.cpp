@@ -0,0 +1,369 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/ByteRangeSort.h>
+#include <cc7/Endian.h>
+#include <algorithm>
+#include <vector>
+#include <string.h>
+#include <atomic>
+#include <thread>
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // Sort entries
+    // -----------------------------------------------------------------
+
+    // Below this size, the group is sorted with std::sort on cached keys.
+    static const size_t s_small_group       = 128;
+    // Below this size, the sort is never parallelized.
+    static const size_t s_parallel_minimum  = 64 * 1024;
+
+    /**
+     The SortEntry keeps the range with 8 bytes of its content, loaded from
+     the current depth, as a big endian number. So comparing the keys is
+     equal to comparing those 8 bytes.
+     */
+    struct SortEntry
+    {
+        U64         key;
+        ByteRange   range;
+    };
+
+    /**
+     Returns number of bytes available at |depth|, up to 8. If the keys are equal,
+     then this value decides the order, because the missing bytes are loaded
+     as zeros to the key. The value 8 means that the next level must be
+     compared.
+     */
+    static inline size_t _Tail(const SortEntry & e, size_t depth)
+    {
+        return std::min<size_t>(e.range.size() - depth, 8);
+    }
+
+    static inline void _LoadKey(SortEntry & e, size_t depth)
+    {
+        const size_t available = e.range.size() - depth;
+        const cc7::byte * p = e.range.data() + depth;
+        if (available >= 8) {
+            e.key = LoadBigEndian<U64>(p);
+        } else {
+            U64 key = 0;
+            for (size_t i = 0; i < 8; i++) {
+                key = (key << 8) | (i < available ? p[i] : 0);
+            }
+            e.key = key;
+        }
+    }
+
+    struct KeyLess
+    {
+        size_t depth;
+
+        bool operator()(const SortEntry & a, const SortEntry & b) const
+        {
+            if (a.key != b.key) {
+                return a.key < b.key;
+            }
+            return _Tail(a, depth) < _Tail(b, depth);
+        }
+    };
+
+    /**
+     The SortTask describes a group of |n| entries, which have equal key bytes
+     above the |shift|. The keys are loaded from |depth|. The tasks are kept
+     on an explicit stack, so the long common prefixes don't exhaust the
+     thread's stack.
+     */
+    struct SortTask
+    {
+        SortEntry * e;
+        SortEntry * scratch;
+        size_t      n;
+        int         shift;
+        size_t      depth;
+    };
+
+    typedef std::vector<SortTask> SortTaskStack;
+
+    /**
+     Processes the group of entries, already sorted by the key at |depth|. The entries
+     with equal keys and with more data are pushed to the |stack|, to be sorted
+     on the next level.
+     */
+    static void _ResolveTies(SortEntry * e, SortEntry * scratch, size_t n, size_t depth, SortTaskStack & stack)
+    {
+        size_t i = 0;
+        while (i < n) {
+            size_t j = i + 1;
+            while (j < n && e[j].key == e[i].key) {
+                j++;
+            }
+            // The run is sorted by the tail, so entries with more data are at the end.
+            size_t k = j;
+            while (k > i && _Tail(e[k - 1], depth) == 8) {
+                k--;
+            }
+            if (j - k > 1) {
+                const size_t next_depth = depth + 8;
+                for (size_t m = k; m < j; m++) {
+                    _LoadKey(e[m], next_depth);
+                }
+                SortTask task = { e + k, scratch + k, j - k, 56, next_depth };
+                stack.push_back(task);
+            }
+            i = j;
+        }
+    }
+
+    /**
+     Sorts the group by the cached keys with std::sort and resolves the ties.
+     */
+    static void _SortSmallGroup(SortEntry * e, SortEntry * scratch, size_t n, size_t depth, SortTaskStack & stack)
+    {
+        KeyLess less = { depth };
+        std::sort(e, e + n, less);
+        _ResolveTies(e, scratch, n, depth, stack);
+    }
+
+    /**
+     Returns true if all |n| entries have the same key, and all continue behind it.
+     */
+    static bool _AllTied(const SortEntry * e, size_t n, size_t depth)
+    {
+        const U64 key = e[0].key;
+        for (size_t i = 0; i < n; i++) {
+            if (e[i].key != key || _Tail(e[i], depth) != 8) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     Processes one task. The sub-groups, which need more work, are pushed to the |stack|.
+     */
+    static void _ProcessTask(SortTask task, SortTaskStack & stack)
+    {
+        SortEntry * e       = task.e;
+        SortEntry * scratch = task.scratch;
+        const size_t n      = task.n;
+        int shift           = task.shift;
+        size_t depth        = task.depth;
+
+        // The whole group shares the next 8 bytes (typically duplicates, or a long
+        // common prefix), so just move to the next level.
+        while (_AllTied(e, n, depth)) {
+            depth += 8;
+            for (size_t i = 0; i < n; i++) {
+                _LoadKey(e[i], depth);
+            }
+            shift = 56;
+        }
+        if (n < s_small_group) {
+            _SortSmallGroup(e, scratch, n, depth, stack);
+            return;
+        }
+        size_t counts[256];
+        while (true) {
+            memset(counts, 0, sizeof(counts));
+            for (size_t i = 0; i < n; i++) {
+                counts[(e[i].key >> shift) & 0xFF]++;
+            }
+            if (counts[(e[0].key >> shift) & 0xFF] != n) {
+                break;
+            }
+            // All entries have the same byte, skip this pass.
+            if (shift == 0) {
+                _SortSmallGroup(e, scratch, n, depth, stack);
+                return;
+            }
+            shift -= 8;
+        }
+        size_t offsets[256];
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            offsets[b] = offset;
+            offset += counts[b];
+        }
+        for (size_t i = 0; i < n; i++) {
+            scratch[offsets[(e[i].key >> shift) & 0xFF]++] = e[i];
+        }
+        std::copy(scratch, scratch + n, e);
+        offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            const size_t count = counts[b];
+            if (count > 1) {
+                if (shift > 0) {
+                    SortTask sub_task = { e + offset, scratch + offset, count, shift - 8, depth };
+                    stack.push_back(sub_task);
+                } else {
+                    // All key bytes are equal, so only the tail decides.
+                    _SortSmallGroup(e + offset, scratch + offset, count, depth, stack);
+                }
+            }
+            offset += count;
+        }
+    }
+
+    /**
+     Sorts |n| entries, which have equal key bytes above the |shift|.
+     */
+    static void _SortByKey(SortEntry * e, SortEntry * scratch, size_t n, int shift, size_t depth)
+    {
+        SortTaskStack stack;
+        SortTask task = { e, scratch, n, shift, depth };
+        stack.push_back(task);
+        while (!stack.empty()) {
+            task = stack.back();
+            stack.pop_back();
+            _ProcessTask(task, stack);
+        }
+    }
+
+    // -----------------------------------------------------------------
+    // Parallel sort
+    // -----------------------------------------------------------------
+
+    /**
+     Runs |function| on |threads_count| threads, with the thread index as a parameter.
+     The calling thread is used as the first thread.
+     */
+    template <typename Function> static void _RunParallel(size_t threads_count, Function function)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(threads_count - 1);
+        for (size_t t = 1; t < threads_count; t++) {
+            threads.push_back(std::thread(function, t));
+        }
+        function(0);
+        for (auto & thread : threads) {
+            thread.join();
+        }
+    }
+
+    static void _SortParallel(ByteRange * ranges, size_t count, size_t threads_count)
+    {
+        std::vector<SortEntry> entries(count);
+        std::vector<SortEntry> partitioned(count);
+        std::vector<size_t> counts(threads_count * 256, 0);
+        const size_t chunk = (count + threads_count - 1) / threads_count;
+
+        // 1. Load the keys and count the first bytes in each chunk.
+        _RunParallel(threads_count, [&](size_t t) {
+            const size_t begin = std::min(count, t * chunk);
+            const size_t end   = std::min(count, begin + chunk);
+            size_t * thread_counts = &counts[t * 256];
+            for (size_t i = begin; i < end; i++) {
+                entries[i].range = ranges[i];
+                _LoadKey(entries[i], 0);
+                thread_counts[entries[i].key >> 56]++;
+            }
+        });
+        // 2. Calculate where each thread writes its part of each bucket.
+        std::vector<size_t> offsets(threads_count * 256);
+        size_t bucket_offsets[257];
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            bucket_offsets[b] = offset;
+            for (size_t t = 0; t < threads_count; t++) {
+                offsets[t * 256 + b] = offset;
+                offset += counts[t * 256 + b];
+            }
+        }
+        bucket_offsets[256] = offset;
+        // 3. Scatter the entries to buckets, then sort the buckets, with
+        //    the original array as a scratch buffer.
+        std::atomic<size_t> next_bucket(0);
+        _RunParallel(threads_count, [&](size_t t) {
+            const size_t begin = std::min(count, t * chunk);
+            const size_t end   = std::min(count, begin + chunk);
+            size_t * thread_offsets = &offsets[t * 256];
+            for (size_t i = begin; i < end; i++) {
+                partitioned[thread_offsets[entries[i].key >> 56]++] = entries[i];
+            }
+        });
+        _RunParallel(threads_count, [&](size_t) {
+            while (true) {
+                const size_t b = next_bucket.fetch_add(1);
+                if (b >= 256) {
+                    break;
+                }
+                const size_t bucket_begin = bucket_offsets[b];
+                const size_t bucket_size  = bucket_offsets[b + 1] - bucket_begin;
+                if (bucket_size > 1) {
+                    _SortByKey(&partitioned[bucket_begin], &entries[bucket_begin], bucket_size, 48, 0);
+                }
+            }
+        });
+        // 4. Copy the result back.
+        _RunParallel(threads_count, [&](size_t t) {
+            const size_t begin = std::min(count, t * chunk);
+            const size_t end   = std::min(count, begin + chunk);
+            for (size_t i = begin; i < end; i++) {
+                ranges[i] = partitioned[i].range;
+            }
+        });
+    }
+
+    // -----------------------------------------------------------------
+    // Public interface
+    // -----------------------------------------------------------------
+
+    void SortByteRanges(ByteRange * ranges, size_t count, size_t threads_count)
+    {
+        if (count < 2) {
+            return;
+        }
+        if (threads_count == 0) {
+            threads_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        if (threads_count > 1 && count >= s_parallel_minimum) {
+            _SortParallel(ranges, count, threads_count);
+            return;
+        }
+        std::vector<SortEntry> entries(count);
+        std::vector<SortEntry> scratch(count);
+        for (size_t i = 0; i < count; i++) {
+            entries[i].range = ranges[i];
+            _LoadKey(entries[i], 0);
+        }
+        _SortByKey(entries.data(), scratch.data(), count, 56, 0);
+        for (size_t i = 0; i < count; i++) {
+            ranges[i] = entries[i].range;
+        }
+    }
+
+    size_t UniqueByteRanges(ByteRange * ranges, size_t count)
+    {
+        if (count < 2) {
+            return count;
+        }
+        size_t last = 0;
+        for (size_t i = 1; i < count; i++) {
+            const ByteRange & r = ranges[i];
+            const ByteRange & l = ranges[last];
+            const bool equal = r.size() == l.size() &&
+                               (r.size() == 0 || r.data() == l.data() || memcmp(r.data(), l.data(), r.size()) == 0);
+            if (!equal) {
+                ranges[++last] = r;
+            }
+        }
+        return last + 1;
+    }
+
+} // cc7
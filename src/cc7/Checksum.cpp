@@ -0,0 +1,552 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/Checksum.h>
+#include <cc7/ByteChain.h>
+#include <cc7/Endian.h>
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define CC7_CHECKSUM_X86
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+    #define CC7_CHECKSUM_ARM_CRC
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define CC7_CHECKSUM_SSE2
+#endif
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // CRC tables & polynomial arithmetic
+    // -----------------------------------------------------------------
+
+    // Reflected polynomials
+    static const U32 s_crc32_poly   = 0xEDB88320;
+    static const U32 s_crc32c_poly  = 0x82F63B78;
+
+    // Size of one stream in the interleaved CRC32C calculation.
+    static const size_t s_crc_stream_size = 1024;
+
+    /**
+     Multiplies |a| and |b| modulo polynomial |poly|. All values are in
+     the reflected representation. The |a| must not be zero.
+     */
+    static U32 _MultModP(U32 a, U32 b, U32 poly)
+    {
+        U32 m = 1U << 31;
+        U32 p = 0;
+        while (true) {
+            if (a & m) {
+                p ^= b;
+                if ((a & (m - 1)) == 0) {
+                    break;
+                }
+            }
+            m >>= 1;
+            b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+        }
+        return p;
+    }
+
+    struct CrcTables
+    {
+        /// Tables for slicing-by-8 algorithm.
+        U32 slice[8][256];
+        /// x^(2^n) modulo polynomial, for n = 0..31.
+        U32 x2n[32];
+        /// x^(8 * s_crc_stream_size) modulo polynomial.
+        U32 stream_shift;
+        U32 poly;
+
+        CrcTables(U32 polynomial) :
+            poly(polynomial)
+        {
+            for (U32 i = 0; i < 256; i++) {
+                U32 crc = i;
+                for (int k = 0; k < 8; k++) {
+                    crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+                }
+                slice[0][i] = crc;
+            }
+            for (U32 i = 0; i < 256; i++) {
+                for (int k = 1; k < 8; k++) {
+                    slice[k][i] = (slice[k - 1][i] >> 8) ^ slice[0][slice[k - 1][i] & 0xFF];
+                }
+            }
+            x2n[0] = 1U << 30;  // x^1
+            for (int n = 1; n < 32; n++) {
+                x2n[n] = _MultModP(x2n[n - 1], x2n[n - 1], poly);
+            }
+            stream_shift = shiftPolynomial(s_crc_stream_size);
+        }
+
+        /**
+         Returns x^(8 * length) modulo polynomial.
+         */
+        U32 shiftPolynomial(U64 length) const
+        {
+            U32 p = 1U << 31;   // x^0
+            int k = 3;
+            while (length > 0) {
+                if (length & 1) {
+                    p = _MultModP(x2n[k & 31], p, poly);
+                }
+                length >>= 1;
+                k++;
+            }
+            return p;
+        }
+
+        /**
+         Combines two CRC values, the |crc_b| is calculated from the zero state.
+         This works for both, the finalized and the internal values.
+         */
+        U32 combine(U32 crc_a, U32 crc_b, U64 length_b) const
+        {
+            return _MultModP(shiftPolynomial(length_b), crc_a, poly) ^ crc_b;
+        }
+    };
+
+    static const CrcTables & _Crc32Tables()
+    {
+        static const CrcTables s_tables(s_crc32_poly);
+        return s_tables;
+    }
+
+    static const CrcTables & _Crc32cTables()
+    {
+        static const CrcTables s_tables(s_crc32c_poly);
+        return s_tables;
+    }
+
+    // -----------------------------------------------------------------
+    // CRC implementations
+    //
+    // All functions work with the internal CRC state, which is the
+    // inverted checksum.
+    // -----------------------------------------------------------------
+
+    typedef U32 (*CrcFunction)(U32 crc, const cc7::byte * p, size_t size);
+
+    static U32 _CrcSlicing8(const CrcTables & tables, U32 crc, const cc7::byte * p, size_t size)
+    {
+        const U32 (*t)[256] = tables.slice;
+        while (size >= 8) {
+            const U32 lo = LoadLittleEndian<U32>(p) ^ crc;
+            const U32 hi = LoadLittleEndian<U32>(p + 4);
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                  t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            p += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+            size--;
+        }
+        return crc;
+    }
+
+    static U32 _Crc32Table(U32 crc, const cc7::byte * p, size_t size)
+    {
+        return _CrcSlicing8(_Crc32Tables(), crc, p, size);
+    }
+
+    static U32 _Crc32cTable(U32 crc, const cc7::byte * p, size_t size)
+    {
+        return _CrcSlicing8(_Crc32cTables(), crc, p, size);
+    }
+
+#if defined(CC7_CHECKSUM_X86)
+
+    /**
+     CRC32C with SSE4.2 crc32 instruction. The instruction has 3 cycles latency,
+     but one instruction can start in each cycle, so the large input is split
+     into three interleaved streams, combined at the end of each round.
+     */
+    __attribute__((target("sse4.2")))
+    static U32 _Crc32cSse42(U32 crc, const cc7::byte * p, size_t size)
+    {
+        const CrcTables & tables = _Crc32cTables();
+        U64 c0 = crc;
+        while (size >= 3 * s_crc_stream_size) {
+            U64 c1 = 0, c2 = 0;
+            const cc7::byte * p1 = p + s_crc_stream_size;
+            const cc7::byte * p2 = p + 2 * s_crc_stream_size;
+            for (size_t i = 0; i < s_crc_stream_size; i += 8) {
+                U64 v0, v1, v2;
+                memcpy(&v0, p + i, 8);
+                memcpy(&v1, p1 + i, 8);
+                memcpy(&v2, p2 + i, 8);
+                c0 = _mm_crc32_u64(c0, v0);
+                c1 = _mm_crc32_u64(c1, v1);
+                c2 = _mm_crc32_u64(c2, v2);
+            }
+            U32 r = _MultModP(tables.stream_shift, static_cast<U32>(c0), tables.poly) ^ static_cast<U32>(c1);
+            r = _MultModP(tables.stream_shift, r, tables.poly) ^ static_cast<U32>(c2);
+            c0 = r;
+            p += 3 * s_crc_stream_size;
+            size -= 3 * s_crc_stream_size;
+        }
+        while (size >= 8) {
+            U64 v;
+            memcpy(&v, p, 8);
+            c0 = _mm_crc32_u64(c0, v);
+            p += 8;
+            size -= 8;
+        }
+        U32 c = static_cast<U32>(c0);
+        while (size > 0) {
+            c = _mm_crc32_u8(c, *p++);
+            size--;
+        }
+        return c;
+    }
+
+    /**
+     CRC32 with PCLMULQDQ folding, based on the Intel's "Fast CRC Computation
+     for Generic Polynomials Using PCLMULQDQ Instruction" paper. The function
+     processes 64 bytes per iteration with four independent accumulators.
+     */
+    __attribute__((target("pclmul,sse2")))
+    static U32 _Crc32Clmul(U32 crc, const cc7::byte * p, size_t size)
+    {
+        if (size < 64) {
+            return _Crc32Table(crc, p, size);
+        }
+        const size_t tail = size & 15;
+        size -= tail;
+
+        const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+        const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+        const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+        const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+        const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+        const __m128i * v = reinterpret_cast<const __m128i*>(p);
+        __m128i x1 = _mm_loadu_si128(v);
+        __m128i x2 = _mm_loadu_si128(v + 1);
+        __m128i x3 = _mm_loadu_si128(v + 2);
+        __m128i x4 = _mm_loadu_si128(v + 3);
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+        v += 4;
+        size -= 64;
+
+        // Fold by 4 x 128 bits
+        while (size >= 64) {
+            const __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+            const __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+            const __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+            const __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(v));
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(v + 1));
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(v + 2));
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(v + 3));
+            v += 4;
+            size -= 64;
+        }
+        // Fold into 128 bits
+        __m128i x5;
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+        // Fold the remaining 128-bit blocks
+        while (size >= 16) {
+            x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(v)), x5);
+            v++;
+            size -= 16;
+        }
+        // Fold 128 to 64 bits
+        x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, mask);
+        x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        // Barrett reduction to 32 bits
+        x2 = _mm_and_si128(x1, mask);
+        x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+        x2 = _mm_and_si128(x2, mask);
+        x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        crc = static_cast<U32>(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+
+        return _Crc32Table(crc, reinterpret_cast<const cc7::byte*>(v), tail);
+    }
+
+#endif // CC7_CHECKSUM_X86
+
+#if defined(CC7_CHECKSUM_ARM_CRC)
+
+    static U32 _Crc32Arm(U32 crc, const cc7::byte * p, size_t size)
+    {
+        while (size >= 8) {
+            U64 v;
+            memcpy(&v, p, 8);
+            crc = __crc32d(crc, v);
+            p += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            crc = __crc32b(crc, *p++);
+            size--;
+        }
+        return crc;
+    }
+
+    static U32 _Crc32cArm(U32 crc, const cc7::byte * p, size_t size)
+    {
+        while (size >= 8) {
+            U64 v;
+            memcpy(&v, p, 8);
+            crc = __crc32cd(crc, v);
+            p += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            crc = __crc32cb(crc, *p++);
+            size--;
+        }
+        return crc;
+    }
+
+#endif // CC7_CHECKSUM_ARM_CRC
+
+    static CrcFunction _SelectCrc32()
+    {
+    #if defined(CC7_CHECKSUM_ARM_CRC)
+        return _Crc32Arm;
+    #elif defined(CC7_CHECKSUM_X86)
+        if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse2")) {
+            return _Crc32Clmul;
+        }
+    #endif
+        return _Crc32Table;
+    }
+
+    static CrcFunction _SelectCrc32c()
+    {
+    #if defined(CC7_CHECKSUM_ARM_CRC)
+        return _Crc32cArm;
+    #elif defined(CC7_CHECKSUM_X86)
+        if (__builtin_cpu_supports("sse4.2")) {
+            return _Crc32cSse42;
+        }
+    #endif
+        return _Crc32cTable;
+    }
+
+    // Set by the unit tests, to test the table implementation on all CPUs.
+    static std::atomic<bool> s_force_table(false);
+
+    static U32 _Crc32(U32 crc, const ByteRange & data)
+    {
+        static const CrcFunction s_function = _SelectCrc32();
+        const CrcFunction function = s_force_table.load(std::memory_order_relaxed) ? _Crc32Table : s_function;
+        return ~function(~crc, data.data(), data.size());
+    }
+
+    static U32 _Crc32c(U32 crc, const ByteRange & data)
+    {
+        static const CrcFunction s_function = _SelectCrc32c();
+        const CrcFunction function = s_force_table.load(std::memory_order_relaxed) ? _Crc32cTable : s_function;
+        return ~function(~crc, data.data(), data.size());
+    }
+
+namespace detail
+{
+    void Checksum_ForceTableImplementation(bool force)
+    {
+        s_force_table.store(force, std::memory_order_relaxed);
+    }
+} // cc7::detail
+
+    // -----------------------------------------------------------------
+    // Adler32
+    // -----------------------------------------------------------------
+
+    static const U32 s_adler_base = 65521;
+    // The largest n such that 255n(n+1)/2 + (n+1)(BASE-1) fits to 32 bits.
+    static const size_t s_adler_nmax = 5552;
+
+    static U32 _Adler32(U32 adler, const cc7::byte * p, size_t size)
+    {
+        U32 s1 = adler & 0xFFFF;
+        U32 s2 = adler >> 16;
+        while (size > 0) {
+            size_t chunk = std::min(size, s_adler_nmax);
+            size -= chunk;
+        #if defined(CC7_CHECKSUM_SSE2)
+            const size_t blocks = chunk >> 4;
+            if (blocks > 0) {
+                // s1 grows by the sum of bytes, s2 by 16 * s1 + weighted sum of bytes
+                // for each block, with weights 16, 15, ... 1.
+                const __m128i zero      = _mm_setzero_si128();
+                const __m128i weights_1 = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+                const __m128i weights_2 = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+                __m128i v_s1 = zero;    // sum of bytes
+                __m128i v_ps = zero;    // sum of v_s1 before each block
+                __m128i v_s2 = zero;    // weighted sums
+                for (size_t i = 0; i < blocks; i++) {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                    v_ps = _mm_add_epi32(v_ps, v_s1);
+                    v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(block, zero));
+                    v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_unpacklo_epi8(block, zero), weights_1));
+                    v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_unpackhi_epi8(block, zero), weights_2));
+                    p += 16;
+                }
+                U32 lanes[4];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v_s1);
+                const U64 sum = lanes[0] + lanes[2];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v_ps);
+                const U64 prefix_sums = lanes[0] + lanes[2];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v_s2);
+                const U64 weighted = static_cast<U64>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+                const U64 new_s2 = s2 + 16 * blocks * static_cast<U64>(s1) + 16 * prefix_sums + weighted;
+                s1 = static_cast<U32>((s1 + sum) % s_adler_base);
+                s2 = static_cast<U32>(new_s2 % s_adler_base);
+                chunk &= 15;
+            }
+        #endif
+            while (chunk > 0) {
+                s1 += *p++;
+                s2 += s1;
+                chunk--;
+            }
+            s1 %= s_adler_base;
+            s2 %= s_adler_base;
+        }
+        return s1 | (s2 << 16);
+    }
+
+    // -----------------------------------------------------------------
+    // Public interface
+    // -----------------------------------------------------------------
+
+    U32 CRC32_Calculate(const ByteRange & data)
+    {
+        return _Crc32(0, data);
+    }
+
+    U32 CRC32_Calculate(const ByteChain & data)
+    {
+        return CRC32_Update(0, data);
+    }
+
+    U32 CRC32_Update(U32 crc, const ByteRange & data)
+    {
+        return _Crc32(crc, data);
+    }
+
+    U32 CRC32_Update(U32 crc, const ByteChain & data)
+    {
+        for (const ByteRange & segment : data) {
+            crc = _Crc32(crc, segment);
+        }
+        return crc;
+    }
+
+    U32 CRC32_Combine(U32 crc_a, U32 crc_b, U64 length_b)
+    {
+        return _Crc32Tables().combine(crc_a, crc_b, length_b);
+    }
+
+    U32 CRC32C_Calculate(const ByteRange & data)
+    {
+        return _Crc32c(0, data);
+    }
+
+    U32 CRC32C_Calculate(const ByteChain & data)
+    {
+        return CRC32C_Update(0, data);
+    }
+
+    U32 CRC32C_Update(U32 crc, const ByteRange & data)
+    {
+        return _Crc32c(crc, data);
+    }
+
+    U32 CRC32C_Update(U32 crc, const ByteChain & data)
+    {
+        for (const ByteRange & segment : data) {
+            crc = _Crc32c(crc, segment);
+        }
+        return crc;
+    }
+
+    U32 CRC32C_Combine(U32 crc_a, U32 crc_b, U64 length_b)
+    {
+        return _Crc32cTables().combine(crc_a, crc_b, length_b);
+    }
+
+    U32 Adler32_Calculate(const ByteRange & data)
+    {
+        return _Adler32(1, data.data(), data.size());
+    }
+
+    U32 Adler32_Calculate(const ByteChain & data)
+    {
+        return Adler32_Update(1, data);
+    }
+
+    U32 Adler32_Update(U32 adler, const ByteRange & data)
+    {
+        return _Adler32(adler, data.data(), data.size());
+    }
+
+    U32 Adler32_Update(U32 adler, const ByteChain & data)
+    {
+        for (const ByteRange & segment : data) {
+            adler = _Adler32(adler, segment.data(), segment.size());
+        }
+        return adler;
+    }
+
+    U32 Adler32_Combine(U32 adler_a, U32 adler_b, U64 length_b)
+    {
+        const U64 base = s_adler_base;
+        const U64 rem  = length_b % base;
+        U64 sum1 = adler_a & 0xFFFF;
+        U64 sum2 = (rem * sum1) % base;
+        sum1 += (adler_b & 0xFFFF) + base - 1;
+        sum2 += (adler_a >> 16) + (adler_b >> 16) + base - rem;
+        if (sum1 >= base) sum1 -= base;
+        if (sum1 >= base) sum1 -= base;
+        if (sum2 >= (base << 1)) sum2 -= (base << 1);
+        if (sum2 >= base) sum2 -= base;
+        return static_cast<U32>(sum1 | (sum2 << 16));
+    }
+
+} // cc7
@@ -0,0 +1,277 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/DerReader.h>
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // Element parsing
+    // -----------------------------------------------------------------
+
+    /**
+     Parses one DER element from |p|. Returns false if the element is incomplete,
+     or if it's not a valid DER encoding.
+     */
+    static bool _ParseElement(const cc7::byte * p, const cc7::byte * end, DerElement & out_element)
+    {
+        const cc7::byte * start = p;
+        if (p >= end) {
+            return false;
+        }
+        // Identifier
+        const cc7::byte identifier = *p++;
+        U32 tag_number = identifier & 0x1F;
+        if (tag_number == 0x1F) {
+            // High tag number form, base-128 with the continuation bit.
+            tag_number = 0;
+            bool first = true;
+            while (true) {
+                if (p >= end) {
+                    return false;
+                }
+                const cc7::byte b = *p++;
+                if ((first && b == 0x80) || (tag_number >> 25) != 0) {
+                    // Leading zero group, or the number doesn't fit to U32.
+                    return false;
+                }
+                tag_number = (tag_number << 7) | (b & 0x7F);
+                first = false;
+                if ((b & 0x80) == 0) {
+                    break;
+                }
+            }
+            if (tag_number < 31) {
+                // Must be encoded in the low tag number form.
+                return false;
+            }
+        }
+        // Length
+        if (p >= end) {
+            return false;
+        }
+        const cc7::byte length_byte = *p++;
+        size_t length = length_byte;
+        if (length_byte & 0x80) {
+            const size_t length_size = length_byte & 0x7F;
+            if (length_size == 0 || length_size > sizeof(size_t) || length_size > static_cast<size_t>(end - p)) {
+                // Indefinite length is not allowed in DER, or the length is too big.
+                return false;
+            }
+            if (p[0] == 0) {
+                // Leading zero byte
+                return false;
+            }
+            length = 0;
+            for (size_t i = 0; i < length_size; i++) {
+                length = (length << 8) | *p++;
+            }
+            if (length < 0x80) {
+                // Must be encoded in the short form.
+                return false;
+            }
+        }
+        // Value
+        if (length > static_cast<size_t>(end - p)) {
+            return false;
+        }
+        out_element.tag_class   = static_cast<DerElement::TagClass>(identifier >> 6);
+        out_element.constructed = (identifier & 0x20) != 0;
+        out_element.tag_number  = tag_number;
+        out_element.value       = ByteRange(p, length);
+        out_element.encoded     = ByteRange(start, (p - start) + length);
+        return true;
+    }
+
+
+    // -----------------------------------------------------------------
+    // DerReader
+    // -----------------------------------------------------------------
+
+    bool DerReader::peek(DerElement & out_element) const
+    {
+        return _ParseElement(_p, _end, out_element);
+    }
+
+    bool DerReader::read(DerElement & out_element)
+    {
+        if (!_ParseElement(_p, _end, out_element)) {
+            return false;
+        }
+        _p = out_element.encoded.end();
+        return true;
+    }
+
+    bool DerReader::read(cc7::byte identifier, DerElement & out_element)
+    {
+        DerElement element;
+        if (!_ParseElement(_p, _end, element) || !element.hasIdentifier(identifier)) {
+            return false;
+        }
+        _p = element.encoded.end();
+        out_element = element;
+        return true;
+    }
+
+    bool DerReader::readValue(cc7::byte identifier, ByteRange & out_value)
+    {
+        DerElement element;
+        if (!read(identifier, element)) {
+            return false;
+        }
+        out_value = element.value;
+        return true;
+    }
+
+    bool DerReader::skip()
+    {
+        DerElement element;
+        return read(element);
+    }
+
+    bool DerReader::skipIf(cc7::byte identifier)
+    {
+        DerElement element;
+        return read(identifier, element);
+    }
+
+    bool DerReader::enter(cc7::byte identifier, DerReader & out_reader)
+    {
+        DerElement element;
+        if (!_ParseElement(_p, _end, element) || !element.constructed || !element.hasIdentifier(identifier)) {
+            return false;
+        }
+        _p = element.encoded.end();
+        out_reader = DerReader(element.value);
+        return true;
+    }
+
+    bool DerReader::readIntegerBytes(ByteRange & out_value)
+    {
+        DerElement element;
+        if (!_ParseElement(_p, _end, element) || !element.hasIdentifier(DER_INTEGER)) {
+            return false;
+        }
+        const ByteRange & value = element.value;
+        if (value.empty()) {
+            return false;
+        }
+        if (value.size() > 1) {
+            // The first 9 bits must not be all zeros or all ones.
+            if ((value[0] == 0x00 && (value[1] & 0x80) == 0) ||
+                (value[0] == 0xFF && (value[1] & 0x80) != 0)) {
+                return false;
+            }
+        }
+        _p = element.encoded.end();
+        out_value = value;
+        return true;
+    }
+
+    bool DerReader::readInteger(U64 & out_value)
+    {
+        DerReader tmp(*this);
+        ByteRange value;
+        if (!tmp.readIntegerBytes(value) || (value[0] & 0x80) != 0) {
+            // Malformed or negative
+            return false;
+        }
+        if (value[0] == 0) {
+            value.removePrefix(1);
+        }
+        if (value.size() > sizeof(U64)) {
+            return false;
+        }
+        U64 result = 0;
+        for (cc7::byte b : value) {
+            result = (result << 8) | b;
+        }
+        _p = tmp._p;
+        out_value = result;
+        return true;
+    }
+
+    bool DerReader::readBoolean(bool & out_value)
+    {
+        DerElement element;
+        if (!_ParseElement(_p, _end, element) || !element.hasIdentifier(DER_BOOLEAN)) {
+            return false;
+        }
+        if (element.value.size() != 1 || (element.value[0] != 0x00 && element.value[0] != 0xFF)) {
+            return false;
+        }
+        _p = element.encoded.end();
+        out_value = element.value[0] != 0;
+        return true;
+    }
+
+    bool DerReader::readNull()
+    {
+        DerElement element;
+        if (!_ParseElement(_p, _end, element) || !element.hasIdentifier(DER_NULL) || !element.value.empty()) {
+            return false;
+        }
+        _p = element.encoded.end();
+        return true;
+    }
+
+    bool DerReader::readObjectIdentifier(ByteRange & out_oid)
+    {
+        DerElement element;
+        if (!_ParseElement(_p, _end, element) || !element.hasIdentifier(DER_OBJECT_IDENTIFIER)) {
+            return false;
+        }
+        const ByteRange & value = element.value;
+        if (value.empty() || (value[value.size() - 1] & 0x80) != 0) {
+            // Empty, or the last sub-identifier is incomplete.
+            return false;
+        }
+        bool group_start = true;
+        for (cc7::byte b : value) {
+            if (group_start && b == 0x80) {
+                // Sub-identifier with a leading zero group.
+                return false;
+            }
+            group_start = (b & 0x80) == 0;
+        }
+        _p = element.encoded.end();
+        out_oid = value;
+        return true;
+    }
+
+    bool DerReader::readBitString(ByteRange & out_bits, cc7::byte & out_unused_bits)
+    {
+        DerElement element;
+        if (!_ParseElement(_p, _end, element) || !element.hasIdentifier(DER_BIT_STRING)) {
+            return false;
+        }
+        ByteRange value = element.value;
+        if (value.empty() || value[0] > 7) {
+            return false;
+        }
+        const cc7::byte unused_bits = value[0];
+        value.removePrefix(1);
+        if (value.empty() ? unused_bits != 0 : (value[value.size() - 1] & ((1 << unused_bits) - 1)) != 0) {
+            // Empty string with unused bits, or unused bits are not zero.
+            return false;
+        }
+        _p = element.encoded.end();
+        out_bits = value;
+        out_unused_bits = unused_bits;
+        return true;
+    }
+
+} // cc7
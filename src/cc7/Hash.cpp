@@ -0,0 +1,138 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/Hash.h>
+#include <cc7/Endian.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+    #pragma intrinsic(_umul128)
+#endif
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // Helper functions
+    // -----------------------------------------------------------------
+
+    static const U64 s_secret[4] =
+    {
+        0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+        0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+    };
+
+    /**
+     Calculates 128-bit product of |a| and |b|. The low 64 bits are stored
+     to |a| and the high 64 bits to |b|.
+     */
+    static inline void _Multiply(U64 & a, U64 & b)
+    {
+    #if defined(__SIZEOF_INT128__)
+        __uint128_t r = a;
+        r *= b;
+        a = static_cast<U64>(r);
+        b = static_cast<U64>(r >> 64);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+    #else
+        const U64 ha = a >> 32, hb = b >> 32, la = (U32)a, lb = (U32)b;
+        const U64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const U64 t  = rl + (rm0 << 32);
+        U64 carry = t < rl;
+        const U64 lo = t + (rm1 << 32);
+        carry += lo < t;
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    #endif
+    }
+
+    static inline U64 _Mix(U64 a, U64 b)
+    {
+        _Multiply(a, b);
+        return a ^ b;
+    }
+
+    static inline U64 _Read8(const cc7::byte * p)
+    {
+        return LoadLittleEndian<U64>(p);
+    }
+
+    static inline U64 _Read4(const cc7::byte * p)
+    {
+        return LoadLittleEndian<U32>(p);
+    }
+
+    /**
+     Reads 1 up to 3 bytes from |p|.
+     */
+    static inline U64 _Read3(const cc7::byte * p, size_t k)
+    {
+        return (static_cast<U64>(p[0]) << 16) | (static_cast<U64>(p[k >> 1]) << 8) | p[k - 1];
+    }
+
+    // -----------------------------------------------------------------
+    // Public interface
+    // -----------------------------------------------------------------
+
+    U64 Hash64(const ByteRange & data, U64 seed)
+    {
+        const cc7::byte * p = data.data();
+        const size_t length = data.size();
+        U64 a, b;
+
+        seed ^= _Mix(seed ^ s_secret[0], s_secret[1]);
+        if (length <= 16) {
+            if (length >= 4) {
+                // Two overlapping reads cover all bytes.
+                const size_t shift = (length >> 3) << 2;
+                a = (_Read4(p) << 32) | _Read4(p + shift);
+                b = (_Read4(p + length - 4) << 32) | _Read4(p + length - 4 - shift);
+            } else if (length > 0) {
+                a = _Read3(p, length);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = length;
+            if (i > 48) {
+                // Three independent lanes, so the multiplications can run in parallel.
+                U64 see1 = seed, see2 = seed;
+                do {
+                    seed = _Mix(_Read8(p)      ^ s_secret[1], _Read8(p + 8)  ^ seed);
+                    see1 = _Mix(_Read8(p + 16) ^ s_secret[2], _Read8(p + 24) ^ see1);
+                    see2 = _Mix(_Read8(p + 32) ^ s_secret[3], _Read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = _Mix(_Read8(p) ^ s_secret[1], _Read8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            // The last 16 bytes, possibly overlapping with already processed data.
+            a = _Read8(p + i - 16);
+            b = _Read8(p + i - 8);
+        }
+        a ^= s_secret[1];
+        b ^= seed;
+        _Multiply(a, b);
+        return _Mix(a ^ s_secret[0] ^ length, b ^ s_secret[1]);
+    }
+
+} // cc7
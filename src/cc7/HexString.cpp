@@ -15,6 +15,8 @@
  */
 
 #include <cc7/HexString.h>
+#include <cc7/ByteChain.h>
+#include <cc7/MutableByteRange.h>
 
 namespace cc7
 {
@@ -23,12 +25,8 @@ namespace cc7
     static const char s_hex_table_uc[16] = { '0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F' };
     static const char s_hex_table_lc[16] = { '0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f' };
     
-    bool HexString_Encode(const ByteRange & in_data, bool use_lowercase, std::string & out_string)
+    static void _HexString_Append(const ByteRange & in_data, const char * table, std::string & out_string)
     {
-        const char * table = use_lowercase ? s_hex_table_lc : s_hex_table_uc;
-        
-        out_string.clear();
-        out_string.reserve(in_data.size() << 1);
         auto data_it  = in_data.cbegin();
         auto data_end = in_data.cend();
         byte val;
@@ -38,20 +36,38 @@ namespace cc7
             out_string.push_back(table[val & 15]);
             data_it++;
         }
+    }
+    
+    bool HexString_Encode(const ByteRange & in_data, bool use_lowercase, std::string & out_string)
+    {
+        const char * table = use_lowercase ? s_hex_table_lc : s_hex_table_uc;
+        
+        out_string.clear();
+        out_string.reserve(in_data.size() << 1);
+        _HexString_Append(in_data, table, out_string);
+        return true;
+    }
+    
+    bool HexString_Encode(const ByteChain & in_chain, bool use_lowercase, std::string & out_string)
+    {
+        const char * table = use_lowercase ? s_hex_table_lc : s_hex_table_uc;
+        
+        out_string.clear();
+        out_string.reserve(in_chain.size() << 1);
+        for (auto && segment : in_chain) {
+            _HexString_Append(segment, table, out_string);
+        }
         return true;
     }
     
     // MARK: Decoder -
     
-    bool HexString_Decode(const std::string & in_string, ByteArray & out_data)
+    /**
+     Decodes the hexadecimal string to |out_p|. The buffer must have space
+     for (str_len + 1) / 2 bytes. Every byte is written exactly once.
+     */
+    static bool _HexString_Decode(const char * str_p, size_t str_len, byte * out_p)
     {
-        size_t str_len = in_string.length();
-        
-        // Reserve buffer for data
-        out_data.clear();
-        out_data.reserve((str_len >> 1) + (str_len & 1));
-        
-        const char * str_p = in_string.c_str();
         char lc, uc;
         byte lv, uv;
         if (str_len & 1) {
@@ -65,10 +81,9 @@ namespace cc7
                 lv = lc - 'a' + 10;
             } else {
                 // failure
-                out_data.clear();
                 return false;
             }
-            out_data.push_back(lv);
+            *out_p++ = lv;
             str_len--;
         }
         
@@ -82,7 +97,6 @@ namespace cc7
                 uv = uc - 'a' + 10;
             } else {
                 // failure
-                out_data.clear();
                 return false;
             }
             
@@ -95,15 +109,56 @@ namespace cc7
                 lv = lc - 'a' + 10;
             } else {
                 // failure
-                out_data.clear();
                 return false;
             }
-            out_data.push_back((uv << 4) | lv);
+            *out_p++ = (uv << 4) | lv;
             str_p   += 2;
             str_len -= 2;
         }
         // success
         return true;
     }
+    
+    bool HexString_Decode(const std::string & in_string, ByteArray & out_data)
+    {
+        size_t str_len = in_string.length();
+        
+        // Allocate buffer for data. Every byte will be written exactly once.
+        out_data.clear();
+        out_data.resizeUninitialized((str_len >> 1) + (str_len & 1));
+        
+        if (!_HexString_Decode(in_string.c_str(), str_len, out_data.data())) {
+            out_data.clear();
+            return false;
+        }
+        return true;
+    }
+    
+    bool HexString_Decode(const std::string & in_string, MutableByteRange out_buffer, size_t & out_size)
+    {
+        const size_t str_len = in_string.length();
+        const size_t size = (str_len >> 1) + (str_len & 1);
+        out_size = 0;
+        if (size > out_buffer.size()) {
+            return false;
+        }
+        if (!_HexString_Decode(in_string.c_str(), str_len, out_buffer.data())) {
+            return false;
+        }
+        out_size = size;
+        return true;
+    }
+
+    bool HexString_Decode(const std::string & in_string, ByteChain & out_chain)
+    {
+        ByteArray data;
+        if (!HexString_Decode(in_string, data)) {
+            return false;
+        }
+        if (!data.empty()) {
+            out_chain.append(std::move(data));
+        }
+        return true;
+    }
 
-}
\ No newline at end of file
+}
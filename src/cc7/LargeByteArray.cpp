@@ -0,0 +1,283 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/LargeByteArray.h>
+#include <algorithm>
+#include <limits>
+
+#if defined(CC7_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+    #define CC7_HAS_MREMAP
+#endif
+
+namespace cc7
+{
+    const size_t LargeByteArray::MAPPING_THRESHOLD;
+
+    // -----------------------------------------------------------------
+    // Page mapping
+    // -----------------------------------------------------------------
+
+    static size_t _QueryPageSize()
+    {
+    #if defined(CC7_WINDOWS)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+    #else
+        long page_size = sysconf(_SC_PAGESIZE);
+        return page_size > 0 ? page_size : 4096;
+    #endif
+    }
+
+    static size_t _PageSize()
+    {
+        // The initialization of function-local static is thread safe.
+        static const size_t s_page_size = _QueryPageSize();
+        return s_page_size;
+    }
+
+    static cc7::byte * _MapPages(size_t size)
+    {
+    #if defined(CC7_WINDOWS)
+        void * ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (!ptr) {
+            return nullptr;
+        }
+    #else
+        void * ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return nullptr;
+        }
+    #endif
+        detail::AllocationStats_OnAllocate(size);
+        return static_cast<cc7::byte*>(ptr);
+    }
+
+    /**
+     Securely cleans first |touched| bytes and releases the mapping.
+     */
+    static void _UnmapPages(cc7::byte * ptr, size_t size, size_t touched)
+    {
+        CC7_SecureClean(ptr, touched);
+        detail::AllocationStats_OnWipe(touched, false);
+        detail::AllocationStats_OnDeallocate(size);
+    #if defined(CC7_WINDOWS)
+        VirtualFree(ptr, 0, MEM_RELEASE);
+    #else
+        munmap(ptr, size);
+    #endif
+    }
+
+    /**
+     Changes size of the mapping. Only first |touched| bytes are valid in the
+     old mapping. Returns nullptr if the operation failed, in this case the old
+     mapping is unchanged.
+     */
+    static cc7::byte * _RemapPages(cc7::byte * ptr, size_t old_size, size_t new_size, size_t touched)
+    {
+    #if defined(CC7_HAS_MREMAP)
+        // The kernel moves the pages, so there's no copy and no old block to wipe.
+        (void)touched;
+        void * new_ptr = mremap(ptr, old_size, new_size, MREMAP_MAYMOVE);
+        if (new_ptr == MAP_FAILED) {
+            return nullptr;
+        }
+        detail::AllocationStats_OnDeallocate(old_size);
+        detail::AllocationStats_OnAllocate(new_size);
+        detail::AllocationStats_OnReallocation();
+        return static_cast<cc7::byte*>(new_ptr);
+    #else
+        cc7::byte * new_ptr = _MapPages(new_size);
+        if (!new_ptr) {
+            return nullptr;
+        }
+        memcpy(new_ptr, ptr, touched);
+        _UnmapPages(ptr, old_size, touched);
+        detail::AllocationStats_OnReallocation();
+        return new_ptr;
+    #endif
+    }
+
+
+    // -----------------------------------------------------------------
+    // LargeByteArray
+    // -----------------------------------------------------------------
+
+    LargeByteArray::LargeByteArray(LargeByteArray && other) noexcept :
+        _mapped(nullptr),
+        _size(0),
+        _capacity(0),
+        _touched(0)
+    {
+        _moveFrom(other);
+    }
+
+    LargeByteArray & LargeByteArray::operator=(LargeByteArray && other) noexcept
+    {
+        if (this != &other) {
+            secureClear();
+            _moveFrom(other);
+        }
+        return *this;
+    }
+
+    void LargeByteArray::_moveFrom(LargeByteArray & other) noexcept
+    {
+        _small.swap(other._small);
+        _mapped   = other._mapped;
+        _size     = other._size;
+        _capacity = other._capacity;
+        _touched  = other._touched;
+        other._mapped   = nullptr;
+        other._size     = 0;
+        other._capacity = 0;
+        other._touched  = 0;
+    }
+
+    void LargeByteArray::reserve(size_type new_capacity)
+    {
+        if (!_mapped && new_capacity <= MAPPING_THRESHOLD) {
+            _small.reserve(new_capacity);
+        } else if (new_capacity > capacity() || !_mapped) {
+            _grow(new_capacity);
+        }
+    }
+
+    void LargeByteArray::resize(size_type new_size)
+    {
+        if (!_mapped) {
+            if (new_size <= MAPPING_THRESHOLD) {
+                _small.resize(new_size);
+                return;
+            }
+            _grow(new_size);
+        } else if (new_size > _capacity) {
+            _grow(new_size);
+        }
+        if (!_mapped || new_size > _capacity) {
+            // Allocation failed and exceptions are disabled.
+            return;
+        }
+        if (new_size > _size && _size < _touched) {
+            // Clear bytes which have been written before the array was shrunk.
+            // The pages behind _touched are always zero.
+            memset(_mapped + _size, 0, std::min(new_size, _touched) - _size);
+        }
+        _size = new_size;
+        if (_touched < new_size) {
+            _touched = new_size;
+        }
+    }
+
+    LargeByteArray & LargeByteArray::append(const ByteRange & range)
+    {
+        const size_t new_size = size() + range.size();
+        if (!_mapped && new_size <= MAPPING_THRESHOLD) {
+            _small.append(range);
+            return *this;
+        }
+        const cc7::byte * source = range.data();
+        if (!_mapped || new_size > _capacity) {
+            // The range may point to our own data, which is going to move.
+            const bool aliased = source >= data() && source < data() + size();
+            const size_t source_offset = aliased ? source - data() : 0;
+            _grow(new_size);
+            if (!_mapped || new_size > _capacity) {
+                return *this;
+            }
+            if (aliased) {
+                source = _mapped + source_offset;
+            }
+        }
+        if (!range.empty()) {
+            memcpy(_mapped + _size, source, range.size());
+        }
+        _size = new_size;
+        if (_touched < new_size) {
+            _touched = new_size;
+        }
+        return *this;
+    }
+
+    void LargeByteArray::clear() noexcept
+    {
+        if (_mapped) {
+            _size = 0;
+        } else {
+            _small.clear();
+        }
+    }
+
+    void LargeByteArray::secureClear() noexcept
+    {
+        if (_mapped) {
+            _UnmapPages(_mapped, _capacity, _touched);
+            _mapped   = nullptr;
+            _size     = 0;
+            _capacity = 0;
+            _touched  = 0;
+        }
+        // Releases and wipes the array's memory.
+        ByteArray().swap(_small);
+    }
+
+    void LargeByteArray::_grow(size_type required)
+    {
+        const size_t page_size = _PageSize();
+        if (required > std::numeric_limits<size_t>::max() / 2 - page_size) {
+            _ValueTypeExceptions::allocation_error();
+            return;
+        }
+        size_t new_capacity = capacity() * 2;
+        if (new_capacity < required) {
+            new_capacity = required;
+        }
+        new_capacity = (new_capacity + page_size - 1) & ~(page_size - 1);
+
+        if (_mapped) {
+            cc7::byte * new_mapped = _RemapPages(_mapped, _capacity, new_capacity, _touched);
+            if (!new_mapped) {
+                _ValueTypeExceptions::allocation_error();
+                return;
+            }
+            _mapped   = new_mapped;
+            _capacity = new_capacity;
+            return;
+        }
+        // Move the content from the ByteArray to a new mapping.
+        cc7::byte * new_mapped = _MapPages(new_capacity);
+        if (!new_mapped) {
+            _ValueTypeExceptions::allocation_error();
+            return;
+        }
+        _size = _small.size();
+        if (_size > 0) {
+            memcpy(new_mapped, _small.data(), _size);
+        }
+        _mapped   = new_mapped;
+        _capacity = new_capacity;
+        _touched  = _size;
+        ByteArray().swap(_small);
+    }
+
+} // cc7
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/MappedFile.h>
+
+#if defined(CC7_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // Move semantics
+    // -----------------------------------------------------------------
+
+    MappedFile::MappedFile(MappedFile && other) :
+        _data(nullptr),
+        _size(0),
+        _mode(ReadOnly),
+        _is_open(false)
+    {
+        _moveFrom(other);
+    }
+
+    MappedFile & MappedFile::operator=(MappedFile && other)
+    {
+        if (this != &other) {
+            close();
+            _moveFrom(other);
+        }
+        return *this;
+    }
+
+    void MappedFile::_moveFrom(MappedFile & other)
+    {
+        _data    = other._data;
+        _size    = other._size;
+        _mode    = other._mode;
+        _is_open = other._is_open;
+        other._data    = nullptr;
+        other._size    = 0;
+        other._mode    = ReadOnly;
+        other._is_open = false;
+    }
+
+
+#if defined(CC7_WINDOWS)
+
+    // -----------------------------------------------------------------
+    // Windows implementation
+    // -----------------------------------------------------------------
+
+    bool MappedFile::open(const std::string & path, const Options & options)
+    {
+        close();
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  options.access == Sequential ? FILE_FLAG_SEQUENTIAL_SCAN :
+                                  (options.access == Random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL),
+                                  nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || (uint64_t)file_size.QuadPart > (uint64_t)SIZE_MAX) {
+            CloseHandle(file);
+            return false;
+        }
+        if (file_size.QuadPart == 0) {
+            // Empty file cannot be mapped.
+            CloseHandle(file);
+            _mode    = options.mode;
+            _is_open = true;
+            return true;
+        }
+        const DWORD protect = options.mode == CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY;
+        HANDLE mapping = CreateFileMappingA(file, nullptr, protect, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            return false;
+        }
+        const DWORD access = options.mode == CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+        void * ptr = MapViewOfFile(mapping, access, 0, 0, 0);
+        // The view keeps the mapping object alive.
+        CloseHandle(mapping);
+        if (!ptr) {
+            return false;
+        }
+        _data    = static_cast<cc7::byte*>(ptr);
+        _size    = static_cast<size_t>(file_size.QuadPart);
+        _mode    = options.mode;
+        _is_open = true;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (_data) {
+            UnmapViewOfFile(_data);
+        }
+        _data    = nullptr;
+        _size    = 0;
+        _mode    = ReadOnly;
+        _is_open = false;
+    }
+
+    bool MappedFile::advise(AccessPattern access, size_t offset, size_t length)
+    {
+        // Access pattern can be specified only when the file is opened.
+        (void)access;
+        (void)offset;
+        (void)length;
+        return false;
+    }
+
+#else
+
+    // -----------------------------------------------------------------
+    // POSIX implementation
+    // -----------------------------------------------------------------
+
+    static int _MadviseFlag(MappedFile::AccessPattern access)
+    {
+        switch (access) {
+            case MappedFile::Sequential:    return MADV_SEQUENTIAL;
+            case MappedFile::Random:        return MADV_RANDOM;
+            default:                        return MADV_NORMAL;
+        }
+    }
+
+    bool MappedFile::open(const std::string & path, const Options & options)
+    {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        bool result = openDescriptor(fd, options);
+        ::close(fd);
+        return result;
+    }
+
+    bool MappedFile::openDescriptor(int fd, const Options & options)
+    {
+        close();
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            return false;
+        }
+        if ((uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+            return false;
+        }
+        const size_t size = static_cast<size_t>(st.st_size);
+        if (size == 0) {
+            // Empty file cannot be mapped.
+            _mode    = options.mode;
+            _is_open = true;
+            return true;
+        }
+
+        int prot  = PROT_READ;
+        int flags = MAP_SHARED;
+        if (options.mode == CopyOnWrite) {
+            prot  |= PROT_WRITE;
+            flags  = MAP_PRIVATE;
+        }
+    #if defined(MAP_POPULATE)
+        if (options.will_need && options.mode == ReadOnly) {
+            // Prefault the whole file, which is faster than page faults one by one.
+            flags |= MAP_POPULATE;
+        }
+    #endif
+        void * ptr = mmap(nullptr, size, prot, flags, fd, 0);
+        if (ptr == MAP_FAILED) {
+            return false;
+        }
+        _data    = static_cast<cc7::byte*>(ptr);
+        _size    = size;
+        _mode    = options.mode;
+        _is_open = true;
+
+        // Apply hints. All of them are optional, so the failures are ignored.
+        if (options.access != Normal) {
+            advise(options.access);
+        }
+        if (options.will_need) {
+            madvise(ptr, size, MADV_WILLNEED);
+        }
+    #if defined(MADV_HUGEPAGE)
+        if (options.huge_pages) {
+            madvise(ptr, size, MADV_HUGEPAGE);
+        }
+    #endif
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (_data) {
+            munmap(_data, _size);
+        }
+        _data    = nullptr;
+        _size    = 0;
+        _mode    = ReadOnly;
+        _is_open = false;
+    }
+
+    bool MappedFile::advise(AccessPattern access, size_t offset, size_t length)
+    {
+        if (!_data || offset >= _size) {
+            return false;
+        }
+        if (length > _size - offset) {
+            length = _size - offset;
+        }
+        // madvise() requires page aligned address.
+        static const size_t s_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t aligned_offset = offset - (offset % s_page_size);
+        length += offset - aligned_offset;
+        return madvise(_data + aligned_offset, length, _MadviseFlag(access)) == 0;
+    }
+
+#endif // CC7_WINDOWS
+
+} // cc7
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/MutableByteRange.h>
+#include <cc7/Endian.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define CC7_MUTABLE_RANGE_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define CC7_MUTABLE_RANGE_USE_NEON
+#endif
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // Bitwise kernels
+    // -----------------------------------------------------------------
+
+namespace
+{
+    struct XorOperation
+    {
+    #if defined(CC7_MUTABLE_RANGE_USE_SSE2)
+        static __m128i apply(__m128i a, __m128i b)          { return _mm_xor_si128(a, b); }
+    #elif defined(CC7_MUTABLE_RANGE_USE_NEON)
+        static uint8x16_t apply(uint8x16_t a, uint8x16_t b) { return veorq_u8(a, b); }
+    #endif
+        static U64 apply(U64 a, U64 b)                      { return a ^ b; }
+        static cc7::byte apply(cc7::byte a, cc7::byte b)    { return a ^ b; }
+    };
+
+    struct AndOperation
+    {
+    #if defined(CC7_MUTABLE_RANGE_USE_SSE2)
+        static __m128i apply(__m128i a, __m128i b)          { return _mm_and_si128(a, b); }
+    #elif defined(CC7_MUTABLE_RANGE_USE_NEON)
+        static uint8x16_t apply(uint8x16_t a, uint8x16_t b) { return vandq_u8(a, b); }
+    #endif
+        static U64 apply(U64 a, U64 b)                      { return a & b; }
+        static cc7::byte apply(cc7::byte a, cc7::byte b)    { return a & b; }
+    };
+
+    struct OrOperation
+    {
+    #if defined(CC7_MUTABLE_RANGE_USE_SSE2)
+        static __m128i apply(__m128i a, __m128i b)          { return _mm_or_si128(a, b); }
+    #elif defined(CC7_MUTABLE_RANGE_USE_NEON)
+        static uint8x16_t apply(uint8x16_t a, uint8x16_t b) { return vorrq_u8(a, b); }
+    #endif
+        static U64 apply(U64 a, U64 b)                      { return a | b; }
+        static cc7::byte apply(cc7::byte a, cc7::byte b)    { return a | b; }
+    };
+} // anonymous namespace
+
+    /**
+     Applies |Op| to |size| bytes at |p| and |q| and stores the result to |p|.
+     */
+    template <typename Op> static void _Transform(cc7::byte * p, const cc7::byte * q, size_t size)
+    {
+    #if defined(CC7_MUTABLE_RANGE_USE_SSE2)
+        while (size >= 32) {
+            const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+            const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+            const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p),      Op::apply(a0, b0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 16), Op::apply(a1, b1));
+            p += 32;
+            q += 32;
+            size -= 32;
+        }
+    #elif defined(CC7_MUTABLE_RANGE_USE_NEON)
+        while (size >= 16) {
+            vst1q_u8(p, Op::apply(vld1q_u8(p), vld1q_u8(q)));
+            p += 16;
+            q += 16;
+            size -= 16;
+        }
+    #endif
+        while (size >= 8) {
+            U64 a, b;
+            memcpy(&a, p, 8);
+            memcpy(&b, q, 8);
+            a = Op::apply(a, b);
+            memcpy(p, &a, 8);
+            p += 8;
+            q += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            *p = Op::apply(*p, *q);
+            p++;
+            q++;
+            size--;
+        }
+    }
+
+    /**
+     Reverses |size| bytes at |p|.
+     */
+    static void _Reverse(cc7::byte * p, size_t size)
+    {
+        cc7::byte * lo = p;
+        cc7::byte * hi = p + size;
+        // Swap 8 byte words from both ends, with reversed byte order.
+        while (hi - lo >= 16) {
+            hi -= 8;
+            U64 a, b;
+            memcpy(&a, lo, 8);
+            memcpy(&b, hi, 8);
+            a = detail::SwapEndian(a);
+            b = detail::SwapEndian(b);
+            memcpy(lo, &b, 8);
+            memcpy(hi, &a, 8);
+            lo += 8;
+        }
+        while (hi - lo >= 2) {
+            --hi;
+            const cc7::byte tmp = *lo;
+            *lo++ = *hi;
+            *hi = tmp;
+        }
+    }
+
+
+    // -----------------------------------------------------------------
+    // MutableByteRange
+    // -----------------------------------------------------------------
+
+    void MutableByteRange::copyFrom(const ByteRange & source)
+    {
+        if (source.size() > size()) {
+            _ValueTypeExceptions::out_of_range();
+            return;
+        }
+        if (!source.empty()) {
+            memmove(_begin, source.data(), source.size());
+        }
+    }
+
+    void MutableByteRange::xorWith(const ByteRange & other)
+    {
+        if (other.size() < size()) {
+            _ValueTypeExceptions::out_of_range();
+            return;
+        }
+        _Transform<XorOperation>(_begin, other.data(), size());
+    }
+
+    void MutableByteRange::andWith(const ByteRange & other)
+    {
+        if (other.size() < size()) {
+            _ValueTypeExceptions::out_of_range();
+            return;
+        }
+        _Transform<AndOperation>(_begin, other.data(), size());
+    }
+
+    void MutableByteRange::orWith(const ByteRange & other)
+    {
+        if (other.size() < size()) {
+            _ValueTypeExceptions::out_of_range();
+            return;
+        }
+        _Transform<OrOperation>(_begin, other.data(), size());
+    }
+
+    void MutableByteRange::xorWithPattern(const ByteRange & pattern)
+    {
+        const size_t pattern_size = pattern.size();
+        if (pattern_size == 0) {
+            _ValueTypeExceptions::invalid_argument();
+            return;
+        }
+        cc7::byte * p = _begin;
+        size_t remaining = size();
+        if (32 % pattern_size == 0 && remaining >= 32) {
+            // The pattern fits to 32 bytes block exactly, so the whole block
+            // can be processed at once.
+            cc7::byte block[32];
+            for (size_t i = 0; i < 32; i++) {
+                block[i] = pattern[i % pattern_size];
+            }
+            const size_t bulk = remaining & ~static_cast<size_t>(31);
+        #if defined(CC7_MUTABLE_RANGE_USE_SSE2)
+            const __m128i m0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            const __m128i m1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+            for (size_t offset = 0; offset < bulk; offset += 32) {
+                __m128i * v = reinterpret_cast<__m128i*>(p + offset);
+                _mm_storeu_si128(v,     _mm_xor_si128(_mm_loadu_si128(v),     m0));
+                _mm_storeu_si128(v + 1, _mm_xor_si128(_mm_loadu_si128(v + 1), m1));
+            }
+        #else
+            for (size_t offset = 0; offset < bulk; offset += 32) {
+                _Transform<XorOperation>(p + offset, block, 32);
+            }
+        #endif
+            p += bulk;
+            remaining -= bulk;
+        }
+        // The bulk always ends at the pattern's boundary.
+        const cc7::byte * pattern_data = pattern.data();
+        for (size_t i = 0; i < remaining; i++) {
+            p[i] ^= pattern_data[i % pattern_size];
+        }
+    }
+
+    void MutableByteRange::fill(value_type value) noexcept
+    {
+        if (!empty()) {
+            memset(_begin, value, size());
+        }
+    }
+
+    void MutableByteRange::reverse() noexcept
+    {
+        _Reverse(_begin, size());
+    }
+
+    void MutableByteRange::rotate(size_type count)
+    {
+        if (count > size()) {
+            _ValueTypeExceptions::out_of_range();
+            return;
+        }
+        if (count == 0 || count == size()) {
+            return;
+        }
+        // Rotation by three reversals, works in place and in linear time.
+        _Reverse(_begin, count);
+        _Reverse(_begin + count, size() - count);
+        _Reverse(_begin, size());
+    }
+
+} // cc7
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/OwnedBytes.h>
+#include <stdlib.h>
+
+namespace cc7
+{
+    static void _FreeDeleter(cc7::byte * ptr, size_t, void *)
+    {
+        free(ptr);
+    }
+
+    // MARK: - Construction -
+
+    OwnedBytes OwnedBytes::adopt(void * ptr, size_t size, Deleter deleter, void * context, WipePolicy policy)
+    {
+        OwnedBytes result;
+        if (ptr) {
+            if (!deleter) {
+                CC7_ASSERT(false, "OwnedBytes: Deleter is required.");
+                return result;
+            }
+            result._data    = static_cast<cc7::byte*>(ptr);
+            result._size    = size;
+            result._deleter = deleter;
+            result._context = context;
+            result._policy  = policy;
+        }
+        return result;
+    }
+
+    OwnedBytes OwnedBytes::adoptMalloc(void * ptr, size_t size, WipePolicy policy)
+    {
+        return adopt(ptr, size, _FreeDeleter, nullptr, policy);
+    }
+
+    OwnedBytes OwnedBytes::allocate(size_t size)
+    {
+        // malloc(0) may return nullptr, so always allocate at least one byte.
+        void * ptr = malloc(size > 0 ? size : 1);
+        if (!ptr) {
+            detail::ExceptionsWrapper<cc7::byte>::allocation_error();
+            return OwnedBytes();
+        }
+        return adopt(ptr, size, _FreeDeleter, nullptr, Wipe);
+    }
+
+    OwnedBytes OwnedBytes::copyFrom(const ByteRange & range)
+    {
+        OwnedBytes result = allocate(range.size());
+        if (result.data() && !range.empty()) {
+            memcpy(result.data(), range.data(), range.size());
+        }
+        return result;
+    }
+
+    // MARK: - Ownership -
+
+    cc7::byte * OwnedBytes::release(Deleter * out_deleter, void ** out_context) noexcept
+    {
+        cc7::byte * ptr = _data;
+        if (out_deleter) {
+            *out_deleter = _deleter;
+        }
+        if (out_context) {
+            *out_context = _context;
+        }
+        _deleter = nullptr;
+        _context = nullptr;
+        _data = nullptr;
+        _size = 0;
+        return ptr;
+    }
+
+    void OwnedBytes::reset() noexcept
+    {
+        if (_data) {
+            if (_policy == Wipe) {
+                CC7_SecureClean(_data, _size);
+            }
+            _deleter(_data, _size, _context);
+            _deleter = nullptr;
+            _context = nullptr;
+            _data = nullptr;
+        }
+        _size = 0;
+    }
+
+} // cc7
@@ -0,0 +1,396 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/RecyclingPool.h>
+#include <cc7/AllocationStats.h>
+#include <atomic>
+#include <mutex>
+#include <stdlib.h>
+
+namespace cc7
+{
+    const size_t RecyclingPool::SIZE_CLASSES_COUNT;
+    const size_t RecyclingPool::MIN_BLOCK_SIZE;
+    const size_t RecyclingPool::MAX_BLOCK_SIZE;
+    const size_t RecyclingPool::THREAD_CACHE_LIMIT;
+    const size_t RecyclingPool::DEPOT_LIMIT;
+
+    // -----------------------------------------------------------------
+    // Helper functions
+    // -----------------------------------------------------------------
+
+    /**
+     The FreeBlock is a header of released block. All size classes are large
+     enough to keep the pointer to the next block.
+     */
+    struct FreeBlock
+    {
+        FreeBlock * next;
+    };
+
+    static inline size_t _SizeClassIndex(size_t size)
+    {
+        size_t index = 0;
+        size_t block_size = RecyclingPool::MIN_BLOCK_SIZE;
+        while (block_size < size) {
+            block_size <<= 1;
+            index++;
+        }
+        return index;
+    }
+
+    static inline size_t _SizeClassBlockSize(size_t index)
+    {
+        return RecyclingPool::MIN_BLOCK_SIZE << index;
+    }
+
+    static void * _SystemAllocate(size_t size)
+    {
+        void * ptr = malloc(size > 0 ? size : 1);
+        if (!ptr) {
+            detail::ExceptionsWrapper<cc7::byte>::allocation_error();
+        }
+        return ptr;
+    }
+
+    static void _ReleaseList(FreeBlock * block)
+    {
+        while (block) {
+            FreeBlock * next = block->next;
+            free(block);
+            block = next;
+        }
+    }
+
+    // -----------------------------------------------------------------
+    // Global depot
+    // -----------------------------------------------------------------
+
+    /**
+     The Depot is a lock-free stack of free blocks, for one size class. The blocks
+     are pushed with compare-and-swap, but always popped all at once, with a single
+     exchange. This avoids the ABA problem of the classic lock-free stack.
+     */
+    struct Depot
+    {
+        std::atomic<FreeBlock*>     head;
+        std::atomic<size_t>         count;
+    };
+
+    static Depot s_depots[RecyclingPool::SIZE_CLASSES_COUNT];
+    static std::atomic<U64> s_released_blocks(0);
+
+    /**
+     Pushes list of |count| blocks to the depot. If the depot is full, then
+     the blocks are released to the system.
+     */
+    static void _DepotPush(size_t size_class, FreeBlock * first, FreeBlock * last, size_t count)
+    {
+        Depot & depot = s_depots[size_class];
+        if (depot.count.fetch_add(count, std::memory_order_relaxed) + count > RecyclingPool::DEPOT_LIMIT) {
+            depot.count.fetch_sub(count, std::memory_order_relaxed);
+            s_released_blocks.fetch_add(count, std::memory_order_relaxed);
+            last->next = nullptr;
+            _ReleaseList(first);
+            return;
+        }
+        FreeBlock * head = depot.head.load(std::memory_order_relaxed);
+        do {
+            last->next = head;
+        } while (!depot.head.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     Pops up to |max_count| blocks from the depot. Returns number of popped blocks.
+     */
+    static size_t _DepotPop(size_t size_class, size_t max_count, FreeBlock ** out_list)
+    {
+        Depot & depot = s_depots[size_class];
+        FreeBlock * list = depot.head.exchange(nullptr, std::memory_order_acquire);
+        if (!list) {
+            *out_list = nullptr;
+            return 0;
+        }
+        // Take up to max_count blocks
+        size_t count = 1;
+        FreeBlock * last = list;
+        while (last->next && count < max_count) {
+            last = last->next;
+            count++;
+        }
+        FreeBlock * rest = last->next;
+        last->next = nullptr;
+        depot.count.fetch_sub(count, std::memory_order_relaxed);
+        *out_list = list;
+
+        if (rest) {
+            // Return the rest back to the depot.
+            FreeBlock * rest_last = rest;
+            while (rest_last->next) {
+                rest_last = rest_last->next;
+            }
+            FreeBlock * head = depot.head.load(std::memory_order_relaxed);
+            do {
+                rest_last->next = head;
+            } while (!depot.head.compare_exchange_weak(head, rest, std::memory_order_release, std::memory_order_relaxed));
+        }
+        return count;
+    }
+
+    // -----------------------------------------------------------------
+    // Thread cache
+    // -----------------------------------------------------------------
+
+    enum PoolCounter
+    {
+        PC_Hits,
+        PC_Misses,
+        PC_LargeAllocations,
+        PC_DepotRefills,
+        PC_DepotReturns,
+        PC_Count
+    };
+
+    struct ThreadCache;
+
+    /**
+     The CacheRegistry keeps the list of all thread caches, for collecting the
+     statistics. The registry is never destroyed.
+     */
+    struct CacheRegistry
+    {
+        std::mutex      lock;
+        ThreadCache *   caches;
+        U64             retired[PC_Count];
+
+        CacheRegistry() : caches(nullptr)
+        {
+            for (size_t i = 0; i < PC_Count; i++) {
+                retired[i] = 0;
+            }
+        }
+
+        static CacheRegistry & instance()
+        {
+            static CacheRegistry * s_registry = new CacheRegistry();
+            return *s_registry;
+        }
+    };
+
+    /**
+     Set to true once the thread's cache is destroyed. Other thread-local
+     objects may still release their memory after that point.
+     */
+    static thread_local bool s_thread_finished = false;
+
+    /**
+     The ThreadCache contains free lists for the current thread. The counters are
+     updated only by the owning thread, so a plain load and store is enough.
+     */
+    struct ThreadCache
+    {
+        FreeBlock *         lists[RecyclingPool::SIZE_CLASSES_COUNT];
+        size_t              counts[RecyclingPool::SIZE_CLASSES_COUNT];
+        std::atomic<U64>    counters[PC_Count];
+        ThreadCache *       next;
+
+        ThreadCache()
+        {
+            for (size_t i = 0; i < RecyclingPool::SIZE_CLASSES_COUNT; i++) {
+                lists[i]  = nullptr;
+                counts[i] = 0;
+            }
+            for (size_t i = 0; i < PC_Count; i++) {
+                counters[i].store(0, std::memory_order_relaxed);
+            }
+            CacheRegistry & registry = CacheRegistry::instance();
+            std::lock_guard<std::mutex> guard(registry.lock);
+            next = registry.caches;
+            registry.caches = this;
+        }
+
+        ~ThreadCache()
+        {
+            s_thread_finished = true;
+            flush();
+
+            CacheRegistry & registry = CacheRegistry::instance();
+            std::lock_guard<std::mutex> guard(registry.lock);
+            for (size_t i = 0; i < PC_Count; i++) {
+                registry.retired[i] += counters[i].load(std::memory_order_relaxed);
+            }
+            ThreadCache ** pp = &registry.caches;
+            while (*pp) {
+                if (*pp == this) {
+                    *pp = next;
+                    break;
+                }
+                pp = &(*pp)->next;
+            }
+        }
+
+        void add(size_t index, U64 value)
+        {
+            counters[index].store(counters[index].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        /**
+         Moves |count| blocks from the beginning of free list to the depot.
+         */
+        void returnToDepot(size_t size_class, size_t count)
+        {
+            FreeBlock * first = lists[size_class];
+            FreeBlock * last  = first;
+            for (size_t i = 1; i < count; i++) {
+                last = last->next;
+            }
+            lists[size_class]   = last->next;
+            counts[size_class] -= count;
+            _DepotPush(size_class, first, last, count);
+            add(PC_DepotReturns, 1);
+        }
+
+        void flush()
+        {
+            for (size_t i = 0; i < RecyclingPool::SIZE_CLASSES_COUNT; i++) {
+                if (counts[i] > 0) {
+                    returnToDepot(i, counts[i]);
+                }
+            }
+        }
+    };
+
+    static inline ThreadCache * _CurrentCache()
+    {
+        if (s_thread_finished) {
+            return nullptr;
+        }
+        static thread_local ThreadCache s_cache;
+        return &s_cache;
+    }
+
+
+    // -----------------------------------------------------------------
+    // RecyclingPool
+    // -----------------------------------------------------------------
+
+    void * RecyclingPool::allocate(size_t size)
+    {
+        detail::AllocationStats_OnAllocate(size);
+
+        ThreadCache * cache = _CurrentCache();
+        if (size > MAX_BLOCK_SIZE) {
+            if (cache) {
+                cache->add(PC_LargeAllocations, 1);
+            }
+            return _SystemAllocate(size);
+        }
+        const size_t size_class = _SizeClassIndex(size);
+        if (!cache) {
+            // The thread's cache is already destroyed. The block still must have
+            // the full size of its class, because it can be released to a free
+            // list on another thread.
+            return _SystemAllocate(_SizeClassBlockSize(size_class));
+        }
+        FreeBlock * block = cache->lists[size_class];
+        if (!block) {
+            // Try to refill the free list from the depot
+            const size_t count = _DepotPop(size_class, THREAD_CACHE_LIMIT / 2, &cache->lists[size_class]);
+            if (count == 0) {
+                cache->add(PC_Misses, 1);
+                return _SystemAllocate(_SizeClassBlockSize(size_class));
+            }
+            cache->counts[size_class] = count;
+            cache->add(PC_DepotRefills, 1);
+            block = cache->lists[size_class];
+        }
+        cache->lists[size_class] = block->next;
+        cache->counts[size_class]--;
+        cache->add(PC_Hits, 1);
+        return block;
+    }
+
+    void RecyclingPool::deallocate(void * ptr, size_t size)
+    {
+        if (!ptr) {
+            return;
+        }
+        CC7_SecureClean(ptr, size);
+        detail::AllocationStats_OnWipe(size, false);
+        detail::AllocationStats_OnDeallocate(size);
+
+        ThreadCache * cache = _CurrentCache();
+        if (size > MAX_BLOCK_SIZE || !cache) {
+            free(ptr);
+            return;
+        }
+        const size_t size_class = _SizeClassIndex(size);
+        FreeBlock * block = static_cast<FreeBlock*>(ptr);
+        block->next = cache->lists[size_class];
+        cache->lists[size_class] = block;
+        if (++cache->counts[size_class] > THREAD_CACHE_LIMIT) {
+            cache->returnToDepot(size_class, THREAD_CACHE_LIMIT / 2);
+        }
+    }
+
+    void RecyclingPool::flushThreadCache()
+    {
+        ThreadCache * cache = _CurrentCache();
+        if (cache) {
+            cache->flush();
+        }
+    }
+
+    void RecyclingPool::purgeDepot()
+    {
+        for (size_t i = 0; i < SIZE_CLASSES_COUNT; i++) {
+            FreeBlock * list;
+            while (_DepotPop(i, DEPOT_LIMIT, &list) > 0) {
+                _ReleaseList(list);
+            }
+        }
+    }
+
+    RecyclingPool::Statistics RecyclingPool::statistics()
+    {
+        U64 totals[PC_Count];
+        CacheRegistry & registry = CacheRegistry::instance();
+        {
+            std::lock_guard<std::mutex> guard(registry.lock);
+            for (size_t i = 0; i < PC_Count; i++) {
+                totals[i] = registry.retired[i];
+            }
+            for (ThreadCache * cache = registry.caches; cache; cache = cache->next) {
+                for (size_t i = 0; i < PC_Count; i++) {
+                    totals[i] += cache->counters[i].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        Statistics stats;
+        stats.hits              = totals[PC_Hits];
+        stats.misses            = totals[PC_Misses];
+        stats.large_allocations = totals[PC_LargeAllocations];
+        stats.depot_refills     = totals[PC_DepotRefills];
+        stats.depot_returns     = totals[PC_DepotReturns];
+        stats.released_blocks   = s_released_blocks.load(std::memory_order_relaxed);
+        stats.depot_blocks      = 0;
+        for (size_t i = 0; i < SIZE_CLASSES_COUNT; i++) {
+            stats.depot_blocks += s_depots[i].count.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+} // cc7
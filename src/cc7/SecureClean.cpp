@@ -0,0 +1,208 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/Platform.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define CC7_SECURE_CLEAN_X86
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define CC7_SECURE_CLEAN_NEON
+#endif
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 25))
+    #define CC7_HAS_EXPLICIT_BZERO
+#endif
+
+// -----------------------------------------------------------------
+// Secure memory cleanup
+//
+// The CC7SecureCleanImpl() is used by CC7_SecureClean() macro on
+// platforms where the system doesn't provide a fast and reliable
+// routine. The size of the buffer determines the strategy:
+//
+//  - small buffers are cleaned with explicit_bzero(), if available
+//  - medium buffers are cleaned with AVX2 or NEON vector stores
+//  - multi-megabyte buffers are cleaned with non-temporal stores,
+//    to not pollute the CPU caches with data which is no longer needed
+//
+// All vectorized paths end with a compiler barrier, which tells the
+// compiler that the cleaned memory is still observed, so the stores
+// cannot be eliminated as dead.
+// -----------------------------------------------------------------
+
+#define CC7_SECURE_CLEAN_SMALL_LIMIT        256
+#define CC7_SECURE_CLEAN_NON_TEMPORAL_LIMIT (4 * 1024 * 1024)
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define CC7_MEMORY_BARRIER(ptr)     __asm__ __volatile__("" : : "r"(ptr) : "memory")
+#else
+    #define CC7_MEMORY_BARRIER(ptr)
+#endif
+
+namespace cc7
+{
+namespace detail
+{
+    static void _SecureCleanBytes(cc7::byte * p, size_t size)
+    {
+#if defined(CC7_HAS_EXPLICIT_BZERO)
+        explicit_bzero(p, size);
+#else
+        volatile cc7::byte * vp = p;
+        while (size > 0) {
+            *vp++ = 0;
+            --size;
+        }
+#endif
+    }
+
+#if defined(CC7_SECURE_CLEAN_X86)
+
+    #if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("avx2")))
+    static void _SecureCleanAVX2(cc7::byte * p, size_t size)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        while (size >= 128) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p     ), zero);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 32), zero);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 64), zero);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 96), zero);
+            p    += 128;
+            size -= 128;
+        }
+        while (size >= 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), zero);
+            p    += 32;
+            size -= 32;
+        }
+        if (size > 0) {
+            _SecureCleanBytes(p, size);
+        }
+        _mm256_zeroupper();
+    }
+
+    static bool _HasAVX2()
+    {
+        static const bool s_has_avx2 = __builtin_cpu_supports("avx2");
+        return s_has_avx2;
+    }
+    #else
+    static bool _HasAVX2()
+    {
+        return false;
+    }
+    static void _SecureCleanAVX2(cc7::byte *, size_t)
+    {
+    }
+    #endif
+
+    static void _SecureCleanSSE2(cc7::byte * p, size_t size)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        while (size >= 16) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p), zero);
+            p    += 16;
+            size -= 16;
+        }
+        if (size > 0) {
+            _SecureCleanBytes(p, size);
+        }
+    }
+
+    static void _SecureCleanNonTemporal(cc7::byte * p, size_t size)
+    {
+        // Align destination to 16 bytes, required by streaming stores.
+        const size_t head = (16 - (reinterpret_cast<uintptr_t>(p) & 15)) & 15;
+        _SecureCleanBytes(p, head);
+        p    += head;
+        size -= head;
+
+        const __m128i zero = _mm_setzero_si128();
+        while (size >= 64) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(p     ), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(p + 16), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(p + 32), zero);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(p + 48), zero);
+            p    += 64;
+            size -= 64;
+        }
+        // Make streaming stores globally visible before the memory is released.
+        _mm_sfence();
+        _SecureCleanSSE2(p, size);
+    }
+
+    static void _SecureCleanVector(cc7::byte * p, size_t size)
+    {
+        if (size >= CC7_SECURE_CLEAN_NON_TEMPORAL_LIMIT) {
+            _SecureCleanNonTemporal(p, size);
+        } else if (_HasAVX2()) {
+            _SecureCleanAVX2(p, size);
+        } else {
+            _SecureCleanSSE2(p, size);
+        }
+    }
+
+#elif defined(CC7_SECURE_CLEAN_NEON)
+
+    static void _SecureCleanVector(cc7::byte * p, size_t size)
+    {
+        const uint8x16_t zero = vdupq_n_u8(0);
+        while (size >= 64) {
+            vst1q_u8(p     , zero);
+            vst1q_u8(p + 16, zero);
+            vst1q_u8(p + 32, zero);
+            vst1q_u8(p + 48, zero);
+            p    += 64;
+            size -= 64;
+        }
+        while (size >= 16) {
+            vst1q_u8(p, zero);
+            p    += 16;
+            size -= 16;
+        }
+        if (size > 0) {
+            _SecureCleanBytes(p, size);
+        }
+    }
+
+#else
+
+    static void _SecureCleanVector(cc7::byte * p, size_t size)
+    {
+        memset(p, 0, size);
+    }
+
+#endif
+
+} // cc7::detail
+} // cc7
+
+void CC7SecureCleanImpl(void * ptr, size_t size)
+{
+    if (!ptr || size == 0) {
+        return;
+    }
+    cc7::byte * p = reinterpret_cast<cc7::byte*>(ptr);
+    if (size < CC7_SECURE_CLEAN_SMALL_LIMIT) {
+        cc7::detail::_SecureCleanBytes(p, size);
+    } else {
+        cc7::detail::_SecureCleanVector(p, size);
+    }
+    CC7_MEMORY_BARRIER(ptr);
+}
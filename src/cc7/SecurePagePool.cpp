@@ -0,0 +1,333 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/SecurePagePool.h>
+
+#if !defined(CC7_WINDOWS)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // Platform specific memory mapping
+    // -----------------------------------------------------------------
+
+#if defined(CC7_WINDOWS)
+
+    static size_t _GetPageSize()
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+    }
+
+    static void * _MapPages(size_t size)
+    {
+        return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    }
+
+    static void _UnmapPages(void * ptr, size_t size)
+    {
+        VirtualFree(ptr, 0, MEM_RELEASE);
+    }
+
+    static bool _LockPages(void * ptr, size_t size)
+    {
+        return VirtualLock(ptr, size) != FALSE;
+    }
+
+    static void _UnlockPages(void * ptr, size_t size)
+    {
+        VirtualUnlock(ptr, size);
+    }
+
+    static void _ProtectPages(void * ptr, size_t size)
+    {
+        DWORD old_protect;
+        VirtualProtect(ptr, size, PAGE_NOACCESS, &old_protect);
+    }
+
+#else
+
+    static size_t _GetPageSize()
+    {
+        long page_size = sysconf(_SC_PAGESIZE);
+        return page_size > 0 ? static_cast<size_t>(page_size) : 4096;
+    }
+
+    static void * _MapPages(size_t size)
+    {
+        void * ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return nullptr;
+        }
+    #if defined(MADV_DONTDUMP)
+        madvise(ptr, size, MADV_DONTDUMP);
+    #endif
+        return ptr;
+    }
+
+    static void _UnmapPages(void * ptr, size_t size)
+    {
+        munmap(ptr, size);
+    }
+
+    static bool _LockPages(void * ptr, size_t size)
+    {
+        return mlock(ptr, size) == 0;
+    }
+
+    static void _UnlockPages(void * ptr, size_t size)
+    {
+        munlock(ptr, size);
+    }
+
+    static void _ProtectPages(void * ptr, size_t size)
+    {
+        mprotect(ptr, size, PROT_NONE);
+    }
+
+#endif // CC7_WINDOWS
+
+    // -----------------------------------------------------------------
+    // Helper functions
+    // -----------------------------------------------------------------
+
+    static inline size_t _RoundToPages(size_t size, size_t page_size)
+    {
+        return ((size + page_size - 1) / page_size) * page_size;
+    }
+
+    static inline size_t _SizeClassIndex(size_t size)
+    {
+        size_t index = 0;
+        size_t slot_size = SecurePagePool::MIN_SLOT_SIZE;
+        while (slot_size < size) {
+            slot_size <<= 1;
+            index++;
+        }
+        return index;
+    }
+
+    static inline size_t _SizeClassSlotSize(size_t index)
+    {
+        return SecurePagePool::MIN_SLOT_SIZE << index;
+    }
+
+
+    // -----------------------------------------------------------------
+    // SecurePagePool
+    // -----------------------------------------------------------------
+
+    const size_t SecurePagePool::SIZE_CLASSES_COUNT;
+    const size_t SecurePagePool::MIN_SLOT_SIZE;
+    const size_t SecurePagePool::MAX_SLOT_SIZE;
+
+    SecurePagePool::SecurePagePool(const Config & config) :
+        _config(config),
+        _page_size(_GetPageSize()),
+        _regions(nullptr)
+    {
+        _config.region_size = _RoundToPages(std::max(_config.region_size, MAX_SLOT_SIZE), _page_size);
+        for (size_t i = 0; i < SIZE_CLASSES_COUNT; i++) {
+            _free_lists[i] = nullptr;
+        }
+        memset(&_stats, 0, sizeof(_stats));
+    }
+
+    SecurePagePool::~SecurePagePool()
+    {
+        Region * region = _regions;
+        while (region) {
+            Region * next = region->next;
+            _unmapRegion(*region);
+            delete region;
+            region = next;
+        }
+        for (auto && item : _large_blocks) {
+            _unmapRegion(item.second);
+        }
+    }
+
+    SecurePagePool & SecurePagePool::sharedPool()
+    {
+        // The shared instance is intentionally leaked, because some static
+        // objects may still release their secure buffers at exit.
+        static SecurePagePool * s_pool = new SecurePagePool();
+        return *s_pool;
+    }
+
+    void * SecurePagePool::_mapRegion(size_t size, Region & region)
+    {
+        const size_t guard_size = _config.guard_pages ? _page_size : 0;
+        region.mapping_size = size + 2 * guard_size;
+        region.mapping      = _MapPages(region.mapping_size);
+        region.locked       = false;
+        region.next         = nullptr;
+        if (!region.mapping) {
+            return nullptr;
+        }
+        byte * usable = reinterpret_cast<byte*>(region.mapping) + guard_size;
+        if (guard_size > 0) {
+            _ProtectPages(region.mapping, guard_size);
+            _ProtectPages(usable + size, guard_size);
+        }
+        if (_config.lock_memory) {
+            region.locked = _LockPages(usable, size);
+            if (region.locked) {
+                _stats.locked_bytes += size;
+            } else {
+                _stats.lock_failures++;
+            }
+        }
+        _stats.mapped_bytes += region.mapping_size;
+        return usable;
+    }
+
+    void SecurePagePool::_unmapRegion(const Region & region)
+    {
+        const size_t guard_size = _config.guard_pages ? _page_size : 0;
+        const size_t size = region.mapping_size - 2 * guard_size;
+        byte * usable = reinterpret_cast<byte*>(region.mapping) + guard_size;
+        if (region.locked) {
+            _UnlockPages(usable, size);
+            _stats.locked_bytes -= size;
+        }
+        _UnmapPages(region.mapping, region.mapping_size);
+        _stats.mapped_bytes -= region.mapping_size;
+    }
+
+    bool SecurePagePool::_addRegion(size_t size_class)
+    {
+        Region * region = new Region();
+        byte * usable = reinterpret_cast<byte*>(_mapRegion(_config.region_size, *region));
+        if (!usable) {
+            delete region;
+            return false;
+        }
+        region->next = _regions;
+        _regions = region;
+        _stats.regions++;
+
+        // Carve the region into slots and push them to the free list.
+        const size_t slot_size = _SizeClassSlotSize(size_class);
+        const size_t count = _config.region_size / slot_size;
+        FreeSlot * head = _free_lists[size_class];
+        for (size_t i = count; i > 0; i--) {
+            FreeSlot * slot = reinterpret_cast<FreeSlot*>(usable + (i - 1) * slot_size);
+            slot->next = head;
+            head = slot;
+        }
+        _free_lists[size_class] = head;
+        _stats.free_slots += count;
+        return true;
+    }
+
+    void * SecurePagePool::allocate(size_t size)
+    {
+        if (size > MAX_SLOT_SIZE) {
+            // Large block has its own mapping.
+            std::lock_guard<std::mutex> lock(_lock);
+            Region region;
+            void * ptr = _mapRegion(_RoundToPages(size, _page_size), region);
+            if (!ptr) {
+                detail::ExceptionsWrapper<byte>::allocation_error();
+                return nullptr;
+            }
+#if !defined(CC7_NO_EXCEPTIONS)
+            // The pages are already mapped and locked, so don't leak them
+            // when the map insert fails.
+            try {
+                _large_blocks[ptr] = region;
+            } catch (...) {
+                _unmapRegion(region);
+                throw;
+            }
+#else
+            _large_blocks[ptr] = region;
+#endif
+            _stats.allocations++;
+            _stats.large_allocations++;
+            _stats.used_bytes += size;
+            return ptr;
+        }
+
+        const size_t size_class = _SizeClassIndex(size);
+
+        std::lock_guard<std::mutex> lock(_lock);
+        FreeSlot * slot = _free_lists[size_class];
+        if (!slot) {
+            if (!_addRegion(size_class)) {
+                detail::ExceptionsWrapper<byte>::allocation_error();
+                return nullptr;
+            }
+            slot = _free_lists[size_class];
+        }
+        _free_lists[size_class] = slot->next;
+        slot->next = nullptr;
+
+        _stats.allocations++;
+        _stats.used_slots++;
+        _stats.free_slots--;
+        _stats.used_bytes += _SizeClassSlotSize(size_class);
+        return slot;
+    }
+
+    void SecurePagePool::deallocate(void * ptr, size_t size)
+    {
+        if (!ptr) {
+            return;
+        }
+        if (size > MAX_SLOT_SIZE) {
+            CC7_SecureClean(ptr, _RoundToPages(size, _page_size));
+
+            std::lock_guard<std::mutex> lock(_lock);
+            auto it = _large_blocks.find(ptr);
+            if (it == _large_blocks.end()) {
+                CC7_ASSERT(false, "SecurePagePool: Releasing unknown block.");
+                return;
+            }
+            _unmapRegion(it->second);
+            _large_blocks.erase(it);
+            _stats.deallocations++;
+            _stats.used_bytes -= size;
+            return;
+        }
+
+        const size_t size_class = _SizeClassIndex(size);
+        const size_t slot_size  = _SizeClassSlotSize(size_class);
+        CC7_SecureClean(ptr, slot_size);
+
+        std::lock_guard<std::mutex> lock(_lock);
+        FreeSlot * slot = reinterpret_cast<FreeSlot*>(ptr);
+        slot->next = _free_lists[size_class];
+        _free_lists[size_class] = slot;
+
+        _stats.deallocations++;
+        _stats.used_slots--;
+        _stats.free_slots++;
+        _stats.used_bytes -= slot_size;
+    }
+
+    SecurePagePool::Statistics SecurePagePool::statistics() const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _stats;
+    }
+
+} // cc7
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/Varint.h>
+#include <cc7/Endian.h>
+#include <cc7/Utilities.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define CC7_VARINT_USE_SSE2
+#endif
+
+namespace cc7
+{
+    // -----------------------------------------------------------------
+    // Helper functions
+    // -----------------------------------------------------------------
+
+    static const U64 s_high_bits    = 0x8080808080808080ULL;
+    static const U64 s_low_bits     = 0x7F7F7F7F7F7F7F7FULL;
+
+    template <typename T> struct VarintTraits;
+
+    template <> struct VarintTraits<U32>
+    {
+        static const size_t max_size  = VARINT_MAX_SIZE_U32;
+        // Number of value bits in the last byte
+        static const size_t last_bits = 32 - 7 * (VARINT_MAX_SIZE_U32 - 1);
+    };
+
+    template <> struct VarintTraits<U64>
+    {
+        static const size_t max_size  = VARINT_MAX_SIZE_U64;
+        static const size_t last_bits = 64 - 7 * (VARINT_MAX_SIZE_U64 - 1);
+    };
+
+    /**
+     Joins 7-bit groups from up to 8 bytes, stored in |w| in little endian order,
+     into one 56-bit value. The continuation bits must be already cleared.
+     */
+    static inline U64 _CompactGroups(U64 w)
+    {
+        w = ((w & 0x7F007F007F007F00ULL) >> 1) | (w & 0x007F007F007F007FULL);
+        w = ((w & 0x3FFF00003FFF0000ULL) >> 2) | (w & 0x00003FFF00003FFFULL);
+        w = ((w & 0x0FFFFFFF00000000ULL) >> 4) | (w & 0x000000000FFFFFFFULL);
+        return w;
+    }
+
+    /**
+     Decodes one varint from the |p| pointer. This is the slow path, processing
+     the input byte by byte.
+     */
+    template <typename T> static bool _DecodeOne(const cc7::byte * p, const cc7::byte * end, T & out_value, size_t & out_size)
+    {
+        const size_t max_size = VarintTraits<T>::max_size;
+        const size_t available = end - p;
+        U64 value = 0;
+        for (size_t i = 0; i < max_size && i < available; i++) {
+            const cc7::byte b = p[i];
+            if (i == max_size - 1 && (b >> VarintTraits<T>::last_bits) != 0) {
+                // Too many bits in the last byte, or the continuation bit is set.
+                return false;
+            }
+            value |= static_cast<U64>(b & 0x7F) << (7 * i);
+            if ((b & 0x80) == 0) {
+                out_value = static_cast<T>(value);
+                out_size  = i + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename T> static size_t _DecodeArray(const ByteRange & in_data, T * out_values, size_t count, size_t & out_consumed)
+    {
+        const cc7::byte * p   = in_data.data();
+        const cc7::byte * end = p + in_data.size();
+        size_t n = 0;
+        bool malformed = false;
+
+        while (n < count && !malformed) {
+            const size_t available = end - p;
+        #if defined(CC7_VARINT_USE_SSE2)
+            if (available >= 16 && count - n >= 16) {
+                // Check 16 continuation bits at once.
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                if (_mm_movemask_epi8(chunk) == 0) {
+                    for (size_t i = 0; i < 16; i++) {
+                        out_values[n + i] = p[i];
+                    }
+                    n += 16;
+                    p += 16;
+                    continue;
+                }
+            }
+        #endif
+            if (available >= 8) {
+                U64 word  = LoadLittleEndian<U64>(p);
+                U64 stops = ~word & s_high_bits;
+                if (stops == s_high_bits && count - n >= 8) {
+                    // 8 single byte varints
+                    for (size_t i = 0; i < 8; i++) {
+                        out_values[n + i] = p[i];
+                    }
+                    n += 8;
+                    p += 8;
+                    continue;
+                }
+                // Each cleared high bit terminates one varint. Decode all varints,
+                // which are complete in this word.
+                size_t consumed = 0;
+                while (stops != 0 && n < count) {
+                    const size_t size = (utilities::CountTrailingZeros(stops) + 1) >> 3;
+                    if (size > VarintTraits<T>::max_size) {
+                        malformed = true;
+                        break;
+                    }
+                    const U64 group = size < 8 ? word & ((1ULL << (size * 8)) - 1) : word;
+                    if (size == VarintTraits<T>::max_size && ((group >> (8 * (size - 1))) >> VarintTraits<T>::last_bits) != 0) {
+                        malformed = true;
+                        break;
+                    }
+                    out_values[n++] = static_cast<T>(_CompactGroups(group & s_low_bits));
+                    consumed += size;
+                    if (size < 8) {
+                        word  >>= size * 8;
+                        stops >>= size * 8;
+                    } else {
+                        stops = 0;
+                    }
+                }
+                p += consumed;
+                if (consumed > 0 || malformed) {
+                    continue;
+                }
+                // No varint ends in this word. That's a long U64 varint, or malformed data.
+            }
+            T value;
+            size_t size;
+            if (!_DecodeOne(p, end, value, size)) {
+                break;
+            }
+            out_values[n++] = value;
+            p += size;
+        }
+        out_consumed = p - in_data.data();
+        return n;
+    }
+
+    template <typename T> static void _EncodeArray(const T * values, size_t count, ByteArray & out_data)
+    {
+        size_t encoded_size = 0;
+        for (size_t i = 0; i < count; i++) {
+            encoded_size += Varint_EncodedSize(values[i]);
+        }
+        size_t offset = out_data.size();
+        out_data.resizeUninitialized(offset + encoded_size);
+        cc7::byte * p = out_data.data() + offset;
+        for (size_t i = 0; i < count; i++) {
+            p += Varint_Encode(values[i], p);
+        }
+    }
+
+    // -----------------------------------------------------------------
+    // Public interface
+    // -----------------------------------------------------------------
+
+    size_t Varint_EncodedSize(U64 value)
+    {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    size_t Varint_Encode(U64 value, cc7::byte * out_buffer)
+    {
+        cc7::byte * p = out_buffer;
+        while (value >= 0x80) {
+            *p++ = static_cast<cc7::byte>(value | 0x80);
+            value >>= 7;
+        }
+        *p++ = static_cast<cc7::byte>(value);
+        return p - out_buffer;
+    }
+
+    void Varint_EncodeArray(const U32 * values, size_t count, ByteArray & out_data)
+    {
+        _EncodeArray(values, count, out_data);
+    }
+
+    void Varint_EncodeArray(const U64 * values, size_t count, ByteArray & out_data)
+    {
+        _EncodeArray(values, count, out_data);
+    }
+
+    bool Varint_Decode(const ByteRange & in_data, U32 & out_value, size_t & out_size)
+    {
+        return _DecodeOne(in_data.data(), in_data.data() + in_data.size(), out_value, out_size);
+    }
+
+    bool Varint_Decode(const ByteRange & in_data, U64 & out_value, size_t & out_size)
+    {
+        return _DecodeOne(in_data.data(), in_data.data() + in_data.size(), out_value, out_size);
+    }
+
+    size_t Varint_DecodeArray(const ByteRange & in_data, U32 * out_values, size_t count, size_t & out_consumed)
+    {
+        return _DecodeArray(in_data, out_values, count, out_consumed);
+    }
+
+    size_t Varint_DecodeArray(const ByteRange & in_data, U64 * out_values, size_t count, size_t & out_consumed)
+    {
+        return _DecodeArray(in_data, out_values, count, out_consumed);
+    }
+
+} // cc7
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7/WipeQuarantine.h>
+#include <cc7/AllocationStats.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cc7
+{
+    const size_t WipeQuarantine::MIN_BLOCK_SIZE;
+
+    // -----------------------------------------------------------------
+    // Quarantine state
+    // -----------------------------------------------------------------
+
+    struct QuarantineEntry
+    {
+        void *                          ptr;
+        size_t                          size;
+        WipeQuarantine::ReleaseFunction release;
+    };
+
+    /**
+     The QuarantineState keeps the queue of blocks waiting for the cleanup.
+     The state is never destroyed, because the allocator can be used during
+     the static objects destruction.
+     */
+    struct QuarantineState
+    {
+        /// Serializes enable() and disable() calls.
+        std::mutex                      control_lock;
+        /// Protects all following members.
+        std::mutex                      lock;
+        std::condition_variable         work_cond;
+        std::condition_variable         done_cond;
+        std::deque<QuarantineEntry>     queue;
+        std::thread                     thread;
+        bool                            stop;
+        size_t                          pending_blocks;
+        WipeQuarantine::Configuration   config;
+        WipeQuarantine::Statistics      stats;
+        /// Allows a quick check in submit(), without acquiring the lock.
+        std::atomic<bool>               enabled;
+
+        QuarantineState() :
+            stop(false),
+            pending_blocks(0),
+            enabled(false)
+        {
+            memset(&stats, 0, sizeof(stats));
+        }
+
+        static QuarantineState & instance()
+        {
+            static QuarantineState * s_state = new QuarantineState();
+            return *s_state;
+        }
+
+        void run()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while (true) {
+                work_cond.wait(guard, [this] { return stop || !queue.empty(); });
+                if (queue.empty()) {
+                    // Stop has been requested and all blocks are processed.
+                    break;
+                }
+                QuarantineEntry entry = queue.front();
+                queue.pop_front();
+                guard.unlock();
+
+                CC7_SecureClean(entry.ptr, entry.size);
+                detail::AllocationStats_OnWipe(entry.size, false);
+                entry.release(entry.ptr, entry.size);
+
+                guard.lock();
+                stats.pending_bytes -= entry.size;
+                stats.released_blocks++;
+                if (--pending_blocks == 0) {
+                    done_cond.notify_all();
+                }
+            }
+        }
+    };
+
+
+    // -----------------------------------------------------------------
+    // WipeQuarantine
+    // -----------------------------------------------------------------
+
+    void WipeQuarantine::enable(const Configuration & config)
+    {
+        QuarantineState & state = QuarantineState::instance();
+        std::lock_guard<std::mutex> control_guard(state.control_lock);
+        {
+            std::lock_guard<std::mutex> guard(state.lock);
+            state.config = config;
+            if (state.config.min_block_size < MIN_BLOCK_SIZE) {
+                state.config.min_block_size = MIN_BLOCK_SIZE;
+            }
+        }
+        if (!state.thread.joinable()) {
+            state.stop   = false;
+            state.thread = std::thread(&QuarantineState::run, &state);
+            state.enabled.store(true, std::memory_order_release);
+        }
+    }
+
+    void WipeQuarantine::disable()
+    {
+        QuarantineState & state = QuarantineState::instance();
+        std::lock_guard<std::mutex> control_guard(state.control_lock);
+        if (!state.thread.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(state.lock);
+            state.enabled.store(false, std::memory_order_release);
+            state.stop = true;
+        }
+        state.work_cond.notify_one();
+        state.thread.join();
+    }
+
+    bool WipeQuarantine::isEnabled()
+    {
+        return QuarantineState::instance().enabled.load(std::memory_order_acquire);
+    }
+
+    bool WipeQuarantine::submit(void * ptr, size_t size, ReleaseFunction release)
+    {
+        if (!ptr || size < MIN_BLOCK_SIZE) {
+            return false;
+        }
+        QuarantineState & state = QuarantineState::instance();
+        if (!state.enabled.load(std::memory_order_acquire)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> guard(state.lock);
+            if (state.stop || size < state.config.min_block_size) {
+                return false;
+            }
+            if (state.stats.pending_bytes + size > state.config.max_pending_bytes) {
+                state.stats.rejected_blocks++;
+                return false;
+            }
+            QuarantineEntry entry = { ptr, size, release };
+            state.queue.push_back(entry);
+            state.pending_blocks++;
+            state.stats.deferred_blocks++;
+            state.stats.deferred_bytes += size;
+            state.stats.pending_bytes  += size;
+            if (state.stats.peak_pending_bytes < state.stats.pending_bytes) {
+                state.stats.peak_pending_bytes = state.stats.pending_bytes;
+            }
+        }
+        state.work_cond.notify_one();
+        return true;
+    }
+
+    void WipeQuarantine::flush()
+    {
+        QuarantineState & state = QuarantineState::instance();
+        std::unique_lock<std::mutex> guard(state.lock);
+        state.done_cond.wait(guard, [&state] { return state.pending_blocks == 0; });
+    }
+
+    WipeQuarantine::Statistics WipeQuarantine::statistics()
+    {
+        QuarantineState & state = QuarantineState::instance();
+        std::lock_guard<std::mutex> guard(state.lock);
+        return state.stats;
+    }
+
+} // cc7
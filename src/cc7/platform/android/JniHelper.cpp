@@ -110,10 +110,11 @@ namespace jni
         if (env && array) {
             jsize length = env->GetArrayLength(array);
             if (length > 0) {
-                jbyte * bytes = env->GetByteArrayElements(array, 0);
-                if (CC7_CHECK(bytes != nullptr, "JNI: byteArray has no bytes but size greater than 0.")) {
-                    result.assign(bytes, bytes + length);
-                    env->ReleaseByteArrayElements(array, bytes, 0);
+                // Copy the bytes directly to the result, without an intermediate buffer.
+                result.resizeUninitialized(length);
+                env->GetByteArrayRegion(array, 0, length, reinterpret_cast<jbyte*>(result.data()));
+                if (!CC7_CHECK(env->ExceptionCheck() == JNI_FALSE, "JNI: Unable to copy bytes from byteArray.")) {
+                    result.clear();
                 }
             }
         }
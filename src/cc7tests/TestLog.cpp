@@ -18,6 +18,7 @@
 #include <cc7tests/detail/StringUtils.h>
 #include <memory>
 #include <string>
+#include <stdarg.h>
 
 namespace cc7
 {
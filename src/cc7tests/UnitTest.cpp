@@ -16,6 +16,7 @@
 
 #include <cc7tests/UnitTest.h>
 #include <stdexcept>
+#include <stdarg.h>
 
 namespace cc7
 {
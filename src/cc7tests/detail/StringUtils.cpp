@@ -18,6 +18,7 @@
 #include <sstream>
 #include <memory>
 #include <stdlib.h>
+#include <stdarg.h>
 
 namespace cc7
 {
@@ -35,6 +35,24 @@ namespace tests
         CC7_ADD_UNIT_TEST(cc7Base32Tests, list);
         CC7_ADD_UNIT_TEST(cc7Base64Tests, list);
         CC7_ADD_UNIT_TEST(cc7HexStringTests, list);
+        CC7_ADD_UNIT_TEST(cc7SecureSmallByteArrayTests, list);
+        CC7_ADD_UNIT_TEST(cc7SecurePagePoolTests, list);
+        CC7_ADD_UNIT_TEST(cc7SharedBytesTests, list);
+        CC7_ADD_UNIT_TEST(cc7ByteChainTests, list);
+        CC7_ADD_UNIT_TEST(cc7AlignedByteArrayTests, list);
+        CC7_ADD_UNIT_TEST(cc7OwnedBytesTests, list);
+        CC7_ADD_UNIT_TEST(cc7MappedFileTests, list);
+        CC7_ADD_UNIT_TEST(cc7AllocationStatsTests, list);
+        CC7_ADD_UNIT_TEST(cc7RecyclingPoolTests, list);
+        CC7_ADD_UNIT_TEST(cc7ByteReaderWriterTests, list);
+        CC7_ADD_UNIT_TEST(cc7VarintTests, list);
+        CC7_ADD_UNIT_TEST(cc7LargeByteArrayTests, list);
+        CC7_ADD_UNIT_TEST(cc7WipeQuarantineTests, list);
+        CC7_ADD_UNIT_TEST(cc7HashTests, list);
+        CC7_ADD_UNIT_TEST(cc7MutableByteRangeTests, list);
+        CC7_ADD_UNIT_TEST(cc7ChecksumTests, list);
+        CC7_ADD_UNIT_TEST(cc7DerReaderTests, list);
+        CC7_ADD_UNIT_TEST(cc7ByteRangeSortTests, list);
         
         // OpenSSL
         CC7_ADD_UNIT_TEST(cc7OpenSSLIntegration, list);
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/AlignedByteArray.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7AlignedByteArrayTests : public UnitTest
+    {
+    public:
+        cc7AlignedByteArrayTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testAlignment)
+            CC7_REGISTER_TEST_METHOD(testPadding)
+        }
+
+        // Unit tests
+
+        void testAlignment()
+        {
+            AlignedByteArray<> a64;
+            AlignedByteArray<32, false> a32;
+            AlignedByteArray<4096> a4k;
+            for (size_t n = 1; n < 300; n += 7) {
+                ByteArray data = getTestRandomData(n);
+                a64.append(data);
+                a32.append(data);
+                a4k.assign(data);
+                ccstAssertTrue(IsAligned<64>(a64.data()));
+                ccstAssertTrue(IsAligned<32>(a32.data()));
+                ccstAssertTrue(IsAligned<4096>(a4k.data()));
+                ccstAssertEqual(a4k.byteRange(), data);
+            }
+            ccstAssertEqual(a64.byteRange(), a32.byteRange());
+
+            AlignedByteArray<> copy = a64;
+            ccstAssertTrue(IsAligned<64>(copy.data()));
+            ccstAssertEqual(copy.byteRange(), a64.byteRange());
+
+            copy.secureClear();
+            ccstAssertTrue(copy.empty());
+        }
+
+        void testPadding()
+        {
+            AlignedByteArray<64> padded;
+            ccstAssertEqual(PaddedSize(padded), 0);
+            padded.assign({ 1, 2, 3 });
+            ccstAssertEqual(padded.capacity(), 3);
+            ccstAssertEqual(PaddedSize(padded), 64);
+            // Padding is cleared, so it's safe to read the whole block
+            const cc7::byte * p = padded.data();
+            bool padding_is_zero = true;
+            for (size_t i = padded.size(); i < PaddedSize(padded); i++) {
+                padding_is_zero &= p[i] == 0;
+            }
+            ccstAssertTrue(padding_is_zero);
+
+            padded.reserve(65);
+            ccstAssertEqual(PaddedSize(padded), 128);
+
+            AlignedByteArray<16, false> not_padded(ByteRange("Hello"));
+            ccstAssertEqual(PaddedSize(not_padded), not_padded.capacity());
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7AlignedByteArrayTests, "cc7")
+
+} // cc7::tests
+} // cc7
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/AllocationStats.h>
+#include <thread>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7AllocationStatsTests : public UnitTest
+    {
+    public:
+        cc7AllocationStatsTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testStatistics)
+            CC7_REGISTER_TEST_METHOD(testGrowthPaths)
+            CC7_REGISTER_TEST_METHOD(testThreads)
+        }
+
+        // Unit tests
+
+        void testStatistics()
+        {
+            debug::ResetAllocationStatistics();
+            debug::AllocationStatistics s0 = debug::GetAllocationStatistics();
+            if (!debug::HasAllocationStatistics()) {
+                ccstAssertEqual(s0.allocations, 0);
+                ccstAssertEqual(s0.peak_live_bytes, 0);
+                return;
+            }
+            {
+                ByteArray a1(100);
+                ByteArray a2(5000);
+                a2.secureClear();
+                ByteArray a3;
+                a3.reserve(8);
+                for (int i = 0; i < 100; i++) {
+                    a3.append(cc7::byte(i));
+                }
+            }
+            debug::AllocationStatistics s1 = debug::GetAllocationStatistics();
+            ccstAssertTrue(s1.allocations >= s0.allocations + 3);
+            ccstAssertEqual(s1.allocations - s0.allocations, s1.deallocations - s0.deallocations);
+            ccstAssertTrue(s1.allocated_bytes - s0.allocated_bytes >= 5100 + 100);
+            ccstAssertTrue(s1.wiped_bytes - s0.wiped_bytes >= 5100 + 5000);
+            ccstAssertEqual(s1.secure_clears - s0.secure_clears, 1);
+            ccstAssertTrue(s1.reallocations - s0.reallocations >= 3);
+            ccstAssertTrue(s1.peak_live_bytes >= 5100);
+            ccstAssertTrue(s1.size_histogram[3] - s0.size_histogram[3] >= 1);     // 100 bytes
+            ccstAssertTrue(s1.size_histogram[9] - s0.size_histogram[9] >= 1);     // 5000 bytes
+        }
+
+        void testGrowthPaths()
+        {
+            if (!debug::HasAllocationStatistics()) {
+                return;
+            }
+            // Each growth path of ByteArray is counted
+            debug::AllocationStatistics s0 = debug::GetAllocationStatistics();
+            {
+                ByteArray a;
+                for (int i = 0; i < 1000; i++) {
+                    a.push_back(cc7::byte(i));
+                }
+            }
+            debug::AllocationStatistics s1 = debug::GetAllocationStatistics();
+            ccstAssertTrue(s1.allocations - s0.allocations >= 2);
+            ccstAssertEqual(s1.reallocations - s0.reallocations, s1.allocations - s0.allocations - 1);
+            {
+                ByteArray a;
+                for (int i = 0; i < 1000; i++) {
+                    a.emplace_back();
+                    a.insert(a.begin(), cc7::byte(i));
+                }
+            }
+            debug::AllocationStatistics s2 = debug::GetAllocationStatistics();
+            ccstAssertTrue(s2.allocations - s1.allocations >= 2);
+            ccstAssertEqual(s2.reallocations - s1.reallocations, s2.allocations - s1.allocations - 1);
+            {
+                ByteArray a(16);
+                a.reserve(100);
+                a.resize(1000);
+                a.emplace(a.begin(), 1);
+            }
+            debug::AllocationStatistics s3 = debug::GetAllocationStatistics();
+            ccstAssertEqual(s3.reallocations - s2.reallocations, 3);
+        }
+
+        void testThreads()
+        {
+            if (!debug::HasAllocationStatistics()) {
+                return;
+            }
+            debug::AllocationStatistics s0 = debug::GetAllocationStatistics();
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; t++) {
+                threads.push_back(std::thread([]() {
+                    for (int i = 0; i < 1000; i++) {
+                        ByteArray a(64);
+                    }
+                }));
+            }
+            for (auto && t : threads) {
+                t.join();
+            }
+            // Counters from finished threads are preserved
+            debug::AllocationStatistics s1 = debug::GetAllocationStatistics();
+            ccstAssertTrue(s1.allocations - s0.allocations >= 4000);
+            ccstAssertTrue(s1.allocated_bytes - s0.allocated_bytes >= 4000 * 64);
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7AllocationStatsTests, "cc7")
+
+} // cc7::tests
+} // cc7
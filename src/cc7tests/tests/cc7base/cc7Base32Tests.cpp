@@ -29,6 +29,7 @@ namespace tests
             CC7_REGISTER_TEST_METHOD(testEncodePadding);
             CC7_REGISTER_TEST_METHOD(testEncodeNoPadding);
             CC7_REGISTER_TEST_METHOD(testRandomEncodeDecode);
+            CC7_REGISTER_TEST_METHOD(testByteChain);
             CC7_REGISTER_TEST_METHOD(testDecodeWrongPadding);
             CC7_REGISTER_TEST_METHOD(testDecodeWrongNoPadding);
         }
@@ -112,6 +113,37 @@ namespace tests
                 ccstAssertEqual(source_data, padded_dec);
             }
         }
+        
+        void testByteChain()
+        {
+            for (size_t n = 0; n < 50; n++) {
+                ByteArray data = getTestRandomData(n);
+                // Split data into irregular segments, not aligned to Base32 blocks
+                ByteChain chain;
+                size_t offset = 0, step = 1;
+                while (offset < data.size()) {
+                    size_t count = std::min(step, data.size() - offset);
+                    chain.appendBorrowed(data.byteRange().subRange(offset, count));
+                    offset += count;
+                    step = (step % 7) + 1;
+                }
+                std::string padded, plain;
+                ccstAssertTrue(Base32_Encode(chain, true, padded));
+                ccstAssertEqual(padded, ToBase32String(data, true));
+                ccstAssertTrue(Base32_Encode(chain, false, plain));
+                ccstAssertEqual(plain, ToBase32String(data, false));
+                
+                ByteChain decoded;
+                ccstAssertTrue(Base32_Decode(padded, true, decoded));
+                ccstAssertTrue(Base32_Decode(plain, false, decoded));
+                ccstAssertEqual(decoded.size(), 2 * n);
+                ccstAssertEqual(decoded.flatten(), ByteArray(data + data));
+            }
+            ByteChain chain;
+            chain.appendBorrowed(ByteRange("ab"));
+            ccstAssertFalse(Base32_Decode("MZXW6Y", false, chain));
+            ccstAssertEqual(chain.segmentsCount(), 1);
+        }
 
         
         // MARK: - Wrong data
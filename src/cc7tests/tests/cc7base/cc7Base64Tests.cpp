@@ -75,6 +75,22 @@ namespace tests
                 result = padded76_dec == source_data;
                 ccstAssertTrue(result);
                 if (!result) return;
+                
+                // Decode to the buffer, with the exact and with the insufficient size
+                ByteArray buffer(test_size);
+                size_t buffer_size;
+                result = Base64_Decode(padded64, 64, MutableByteRange(buffer), buffer_size);
+                ccstAssertTrue(result);
+                if (!result) return;
+                result = buffer_size == test_size && buffer == source_data;
+                ccstAssertTrue(result);
+                if (!result) return;
+                if (test_size > 0) {
+                    result = Base64_Decode(plain, 0, MutableByteRange(buffer.data(), test_size - 1), buffer_size);
+                    ccstAssertFalse(result);
+                    ccstAssertEqual(buffer_size, 0);
+                    if (result) return;
+                }
             }
         }
         
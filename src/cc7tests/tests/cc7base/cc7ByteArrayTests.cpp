@@ -35,6 +35,9 @@ namespace tests
             CC7_REGISTER_TEST_METHOD(testRelationalOperators)
             CC7_REGISTER_TEST_METHOD(testOtherMethods)
             CC7_REGISTER_TEST_METHOD(testIterators)
+            CC7_REGISTER_TEST_METHOD(testConcatenation)
+            CC7_REGISTER_TEST_METHOD(testSecureClearWatermark)
+            CC7_REGISTER_TEST_METHOD(testResizeUninitialized)
         }
         
         // Helper methods
@@ -399,6 +402,148 @@ namespace tests
             ccstAssertEqual(a2, ByteArray({8, 7, 6, 5, 4, 3, 2, 1}));
         }
         
+        void testConcatenation()
+        {
+            const ByteArray prefix = { 0xAA, 0xBB };
+            const ByteArray nonce  = getTestRandomData(12);
+            const ByteArray body   = getTestRandomData(100);
+            const ByteArray mac    = getTestRandomData(32);
+            
+            ByteArray expected(prefix);
+            expected.append(nonce).append(0x01).append(body).append(mac);
+            
+            // Construction, single allocation
+            ByteArray a1 = prefix + nonce + byte(0x01) + body + mac;
+            ccstAssertEqual(a1, expected);
+            ccstAssertEqual(a1.capacity(), a1.size());
+            
+            // Expression size
+            auto expr = prefix + nonce;
+            ccstAssertEqual(expr.size(), prefix.size() + nonce.size());
+            
+            // Leading byte
+            ByteArray a2 = byte(0x01) + body;
+            ccstAssertEqual(a2.size(), body.size() + 1);
+            ccstAssertEqual(a2[0], 0x01);
+            ccstAssertEqual(a2.byteRange().subRangeFrom(1), body);
+            
+            // Assignment
+            ByteArray a3 = { 1, 2, 3 };
+            a3 = prefix + body.byteRange().subRangeTo(10);
+            ccstAssertEqual(a3, ByteArray(prefix).append(body.byteRange().subRangeTo(10)));
+            
+            // Assignment & append which captures the same array
+            ByteArray a4 = { 1, 2, 3 };
+            a4 = a4 + byte(4) + a4;
+            ccstAssertEqual(a4, ByteArray({1, 2, 3, 4, 1, 2, 3}));
+            a4.append(a4 + a4);
+            ccstAssertEqual(a4.size(), 21);
+            ccstAssertEqual(a4.byteRange().subRangeFrom(7), ByteArray({1, 2, 3, 4, 1, 2, 3, 1, 2, 3, 4, 1, 2, 3}));
+            
+            // Append with reservation hint
+            ByteArray a5(prefix);
+            a5.reserveForAppend(nonce.size() + 1 + body.size() + mac.size());
+            size_t capacity = a5.capacity();
+            a5.append(nonce).append(0x01).append(body).append(mac);
+            ccstAssertEqual(a5, expected);
+            ccstAssertEqual(a5.capacity(), capacity);
+            
+            // Empty segments
+            ByteArray a6 = ByteRange() + ByteRange();
+            ccstAssertTrue(a6.empty());
+        }
+        
+        void testSecureClearWatermark()
+        {
+            ByteArray a1;
+            a1.reserve(1024);
+            ccstAssertEqual(a1.highWatermark(), 0);
+            a1.append(getTestRandomData(100));
+            ccstAssertEqual(a1.highWatermark(), 100);
+            
+            // Shrinking operations keep the watermark
+            a1.resize(50);
+            ccstAssertEqual(a1.highWatermark(), 100);
+            a1.erase(a1.begin(), a1.begin() + 10);
+            a1.pop_back();
+            a1.assign({ 1, 2, 3 });
+            ccstAssertEqual(a1.highWatermark(), 100);
+            a1 = ByteArray(10, 0xCC);
+            ccstAssertEqual(a1.highWatermark(), 10);
+            a1.append(getTestRandomData(200));
+            a1.clear();
+            ccstAssertEqual(a1.highWatermark(), 210);
+            
+            // Only the written bytes are cleaned
+            a1.reserve(1024);
+            a1.resize(300, 0xAA);
+            a1.resize(10);
+            const size_t capacity = a1.capacity();
+            cc7::byte * p = a1.data();
+            p[500] = 0x55;
+            a1.secureClear();
+            ccstAssertEqual(a1.capacity(), capacity);
+            ccstAssertEqual(a1.highWatermark(), 0);
+            bool zeros = true;
+            for (size_t i = 0; i < 300 && zeros; i++) {
+                zeros = p[i] == 0;
+            }
+            ccstAssertTrue(zeros);
+            ccstAssertEqual(p[500], 0x55);
+            
+            // The strict mode cleans whole capacity
+            a1.append(0x01);
+            a1.secureClear(ByteArray::WipeCapacity);
+            ccstAssertEqual(p[0], 0);
+            ccstAssertEqual(p[500], 0);
+            
+            // Swap and move exchange the watermark
+            ByteArray a2(20, 0x11);
+            a2.clear();
+            a1.swap(a2);
+            ccstAssertEqual(a1.highWatermark(), 20);
+            ccstAssertEqual(a2.highWatermark(), 0);
+            ByteArray a3;
+            a3 = std::move(a1);
+            ccstAssertEqual(a3.highWatermark(), 20);
+        }
+        
+        void testResizeUninitialized()
+        {
+            // Regular construction and resize still fill zeros
+            ByteArray a1(100);
+            ccstAssertEqual(a1, ByteArray(100, 0));
+            memset(a1.data(), 0xCC, a1.size());
+            a1.resize(10);
+            a1.resize(100);
+            ccstAssertEqual(a1.byteRange().subRangeFrom(10), ByteArray(90, 0));
+            
+            // Uninitialized resize keeps the previous content
+            memset(a1.data(), 0xCC, a1.size());
+            a1.resize(10);
+            a1.resizeUninitialized(100);
+            ccstAssertEqual(a1.size(), 100);
+            ccstAssertEqual(a1, ByteArray(100, 0xCC));
+            
+            ByteArray data = getTestRandomData(1000);
+            ByteArray a2 = { 1, 2, 3 };
+            a2.resizeUninitialized(3 + data.size());
+            memcpy(a2.data() + 3, data.data(), data.size());
+            ccstAssertEqual(a2.byteRange().subRangeFrom(3), data);
+            ccstAssertEqual(a2.byteRange().subRangeTo(3), ByteArray({ 1, 2, 3 }));
+            ccstAssertEqual(a2.highWatermark(), a2.size());
+            
+            // Emplace without value constructs zero
+            ByteArray a3;
+            a3.assign(64, 0xAB);
+            a3.clear();
+            a3.emplace_back();
+            a3.emplace(a3.begin());
+            a3.emplace_back(0x11);
+            a3.emplace(a3.begin(), 0x22);
+            ccstAssertEqual(a3, ByteArray({ 0x22, 0, 0, 0x11 }));
+        }
+        
     };
     
     CC7_CREATE_UNIT_TEST(cc7ByteArrayTests, "cc7")
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/ByteChain.h>
+#include <cc7/Base64.h>
+#include <cc7/HexString.h>
+
+#if !defined(CC7_WINDOWS)
+#include <unistd.h>
+#endif
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7ByteChainTests : public UnitTest
+    {
+    public:
+        cc7ByteChainTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testAppendPrepend)
+            CC7_REGISTER_TEST_METHOD(testSpliceAndRemove)
+            CC7_REGISTER_TEST_METHOD(testSubChain)
+            CC7_REGISTER_TEST_METHOD(testIOVec)
+            CC7_REGISTER_TEST_METHOD(testReceive)
+            CC7_REGISTER_TEST_METHOD(testCodecs)
+        }
+
+        // Unit tests
+
+        void testAppendPrepend()
+        {
+            ByteChain chain;
+            ccstAssertTrue(chain.empty());
+            ccstAssertEqual(chain.segmentsCount(), 0);
+            ccstAssertTrue(chain.flatten().empty());
+
+            ByteArray body = { 3, 4, 5 };
+            const cc7::byte * body_ptr = body.data();
+            chain.append(std::move(body));
+            ccstAssertEqual(chain.segment(0).data(), body_ptr);
+
+            const cc7::byte trailer[] = { 6, 7 };
+            chain.appendBorrowed(ByteRange(trailer, sizeof(trailer)));
+            ccstAssertEqual(chain.segment(1).data(), trailer);
+
+            SharedBytes header(ByteArray({ 1, 2 }));
+            chain.prepend(header);
+            ccstAssertEqual(header.useCount(), 2);
+
+            // Empty segments are ignored
+            chain.append(ByteArray());
+            chain.prependBorrowed(ByteRange());
+
+            ccstAssertEqual(chain.size(), 7);
+            ccstAssertEqual(chain.segmentsCount(), 3);
+            ccstAssertEqual(chain.flatten(), ByteArray({ 1, 2, 3, 4, 5, 6, 7 }));
+
+            size_t total = 0;
+            for (auto && segment : chain) {
+                total += segment.size();
+            }
+            ccstAssertEqual(total, chain.size());
+
+            // Chain to chain
+            ByteChain other;
+            other.append(chain).prepend(chain);
+            ccstAssertEqual(other.segmentsCount(), 6);
+            ccstAssertEqual(header.useCount(), 4);
+            other.append(other);
+            ccstAssertEqual(other.size(), 28);
+            ccstAssertEqual(other.flatten().byteRange().subRange(14, 7), ByteArray({ 1, 2, 3, 4, 5, 6, 7 }));
+
+            other.clear();
+            chain.clear();
+            ccstAssertEqual(header.useCount(), 1);
+            ccstAssertEqual(chain.size(), 0);
+        }
+
+        void testSpliceAndRemove()
+        {
+            ByteChain chain;
+            chain.append(ByteArray({ 1, 2, 3, 4 }));
+            chain.append(ByteArray({ 5, 6 }));
+
+            ByteChain insert;
+            insert.append(ByteArray({ 0xA, 0xB }));
+
+            // Split in the middle of the first segment
+            chain.splice(2, insert);
+            ccstAssertEqual(chain.segmentsCount(), 4);
+            ccstAssertEqual(chain.flatten(), ByteArray({ 1, 2, 0xA, 0xB, 3, 4, 5, 6 }));
+            // At the segment boundary, no split
+            chain.splice(8, insert);
+            chain.splice(0, insert);
+            ccstAssertEqual(chain.segmentsCount(), 6);
+            ccstAssertEqual(chain.flatten(), ByteArray({ 0xA, 0xB, 1, 2, 0xA, 0xB, 3, 4, 5, 6, 0xA, 0xB }));
+
+            chain.removePrefix(3);
+            ccstAssertEqual(chain.size(), 9);
+            ccstAssertEqual(chain.flatten(), ByteArray({ 2, 0xA, 0xB, 3, 4, 5, 6, 0xA, 0xB }));
+            chain.removePrefix(5);
+            ccstAssertEqual(chain.flatten(), ByteArray({ 5, 6, 0xA, 0xB }));
+            ccstAssertEqual(chain.segmentsCount(), 2);
+            chain.removePrefix(4);
+            ccstAssertTrue(chain.empty());
+            ccstAssertEqual(chain.segmentsCount(), 0);
+
+#if !defined(CC7_NO_EXCEPTIONS)
+            bool exception = false;
+            try {
+                chain.splice(1, insert);
+            } catch (std::out_of_range &) {
+                exception = true;
+            }
+            ccstAssertTrue(exception);
+            exception = false;
+            try {
+                chain.removePrefix(1);
+            } catch (std::out_of_range &) {
+                exception = true;
+            }
+            ccstAssertTrue(exception);
+#endif
+        }
+
+        void testSubChain()
+        {
+            ByteArray data = getTestRandomData(100);
+            ByteChain chain;
+            for (size_t i = 0; i < 10; i++) {
+                chain.append(SharedBytes(data.byteRange().subRange(i * 10, 10)));
+            }
+            ccstAssertEqual(chain.flatten(), data);
+            for (size_t from = 0; from < 100; from += 7) {
+                for (size_t count = 0; count <= 100 - from; count += 13) {
+                    ByteChain sub = chain.subChain(from, count);
+                    ccstAssertEqual(sub.size(), count);
+                    ccstAssertEqual(sub.flatten(), data.byteRange().subRange(from, count));
+                }
+            }
+        }
+
+        void testIOVec()
+        {
+#if !defined(CC7_WINDOWS)
+            ByteChain chain;
+            chain.appendBorrowed(ByteRange("Hello"));
+            chain.appendBorrowed(ByteRange(" "));
+            chain.append(ByteArray(ByteRange("world")));
+
+            std::vector<struct iovec> vec = chain.ioVectors();
+            ccstAssertEqual(vec.size(), 3);
+            ByteArray joined;
+            for (auto && v : vec) {
+                joined.append(ByteRange(v.iov_base, v.iov_len));
+            }
+            ccstAssertEqual(CopyToString(joined), "Hello world");
+
+            struct iovec iov[2];
+            ccstAssertEqual(chain.exportIOVec(iov, 2), 2);
+            ccstAssertEqual(iov[1].iov_len, 1);
+            ccstAssertEqual(chain.exportIOVec(iov, 2, 2), 1);
+            ccstAssertEqual(iov[0].iov_len, 5);
+            ccstAssertEqual(chain.exportIOVec(iov, 2, 3), 0);
+#endif
+        }
+
+        void testReceive()
+        {
+#if !defined(CC7_WINDOWS)
+            int fds[2];
+            ccstAssertEqual(pipe(fds), 0);
+            ccstAssertEqual(write(fds[1], "Hello world", 11), 11);
+
+            ByteChain chain;
+            chain.appendBorrowed(ByteRange(">"));
+            struct iovec iov[4];
+            size_t prepared = chain.prepareReceive(iov, 4, 4);
+            ccstAssertEqual(prepared, 16);
+            ccstAssertEqual(chain.size(), 17);
+            ssize_t received = readv(fds[0], iov, 4);
+            ccstAssertEqual(received, 11);
+            chain.commitReceive(prepared, received > 0 ? received : 0);
+            ccstAssertEqual(chain.size(), 12);
+            ccstAssertEqual(chain.segmentsCount(), 4);
+            ccstAssertEqual(chain.segment(3).size(), 3);
+            ccstAssertEqual(CopyToString(chain.flatten()), ">Hello world");
+
+            // Nothing received
+            prepared = chain.prepareReceive(iov, 2, 100);
+            chain.commitReceive(prepared, 0);
+            ccstAssertEqual(chain.segmentsCount(), 4);
+            ccstAssertEqual(CopyToString(chain.flatten()), ">Hello world");
+
+            chain.removeSuffix(7);
+            ccstAssertEqual(CopyToString(chain.flatten()), ">Hell");
+            close(fds[0]);
+            close(fds[1]);
+#endif
+        }
+
+        void testCodecs()
+        {
+            for (size_t n = 0; n < 50; n++) {
+                ByteArray data = getTestRandomData(n);
+                // Split data into irregular segments
+                ByteChain chain;
+                size_t offset = 0, step = 1;
+                while (offset < data.size()) {
+                    size_t count = std::min(step, data.size() - offset);
+                    chain.appendBorrowed(data.byteRange().subRange(offset, count));
+                    offset += count;
+                    step = (step % 5) + 1;
+                }
+                std::string s1, s2;
+                ccstAssertTrue(Base64_Encode(chain, 0, s1));
+                ccstAssertEqual(s1, ToBase64String(data));
+                ccstAssertTrue(Base64_Encode(chain, 16, s2));
+                ccstAssertEqual(s2, ToBase64String(data, 16));
+
+                ccstAssertTrue(HexString_Encode(chain, true, s1));
+                ccstAssertEqual(s1, ToHexString(data, true));
+
+                ByteChain decoded;
+                ccstAssertTrue(Base64_Decode(s2, 16, decoded));
+                ccstAssertTrue(HexString_Decode(s1, decoded));
+                ccstAssertEqual(decoded.size(), 2 * n);
+                ccstAssertEqual(decoded.flatten(), ByteArray(data + data));
+            }
+            ByteChain chain;
+            chain.appendBorrowed(ByteRange("ab"));
+            ccstAssertFalse(HexString_Decode("xyz", chain));
+            ccstAssertFalse(Base64_Decode("*", 0, chain));
+            ccstAssertEqual(chain.segmentsCount(), 1);
+        }
+
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7ByteChainTests, "cc7")
+
+} // cc7::tests
+} // cc7
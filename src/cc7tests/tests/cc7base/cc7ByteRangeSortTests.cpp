@@ -0,0 +1,200 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/ByteRangeSort.h>
+#include <cc7/ByteArray.h>
+#include <algorithm>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7ByteRangeSortTests : public UnitTest
+    {
+    public:
+        cc7ByteRangeSortTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testSmall)
+            CC7_REGISTER_TEST_METHOD(testAgainstStdSort)
+            CC7_REGISTER_TEST_METHOD(testLongCommonPrefix)
+            CC7_REGISTER_TEST_METHOD(testUnique)
+            CC7_REGISTER_TEST_METHOD(testPerformance)
+        }
+
+        /**
+         Creates |count| ranges in the |arena|. The ranges have random length up to
+         |max_length| and bytes limited by |byte_mask|. If |prefix| is not zero,
+         then all ranges begin with the same |prefix| bytes.
+         */
+        std::vector<ByteRange> makeRanges(ByteArray & arena, size_t count, size_t max_length, cc7::byte byte_mask, size_t prefix = 0)
+        {
+            ByteArray lengths = getTestRandomData(count * 2);
+            arena = getTestRandomData(count * (max_length + prefix) + 1);
+            for (auto & b : arena) {
+                b &= byte_mask;
+            }
+            std::vector<ByteRange> ranges;
+            ranges.reserve(count);
+            size_t offset = 0;
+            for (size_t i = 0; i < count; i++) {
+                const size_t length = prefix + (lengths[2 * i] | (lengths[2 * i + 1] << 8)) % (max_length + 1);
+                if (prefix > 0) {
+                    memset(arena.data() + offset, 0x5A, prefix);
+                }
+                ranges.push_back(arena.byteRange().subRange(offset, length));
+                offset += length;
+            }
+            return ranges;
+        }
+
+        bool sortsLikeStdSort(const std::vector<ByteRange> & source, size_t threads_count)
+        {
+            std::vector<ByteRange> expected(source);
+            std::sort(expected.begin(), expected.end());
+            std::vector<ByteRange> sorted(source);
+            SortByteRanges(sorted, threads_count);
+            if (sorted.size() != expected.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < sorted.size(); i++) {
+                if (sorted[i] != expected[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Unit tests
+
+        void testSmall()
+        {
+            ByteArray zero = { 0x00 };
+            ByteArray zero_zero = { 0x00, 0x00 };
+            std::vector<ByteRange> ranges = {
+                ByteRange("banana"), ByteRange("apple"), ByteRange(""), ByteRange("app"),
+                ByteRange("apple pie with cream"), ByteRange("apple pie"), zero_zero.byteRange(),
+                zero.byteRange(), ByteRange("app"), ByteRange("apple pie with cheese")
+            };
+            SortByteRanges(ranges);
+            const std::vector<ByteRange> expected = {
+                ByteRange(""), zero.byteRange(), zero_zero.byteRange(), ByteRange("app"), ByteRange("app"),
+                ByteRange("apple"), ByteRange("apple pie"), ByteRange("apple pie with cheese"),
+                ByteRange("apple pie with cream"), ByteRange("banana")
+            };
+            ccstAssertTrue(ranges == expected);
+            
+            std::vector<ByteRange> empty;
+            SortByteRanges(empty);
+            ccstAssertTrue(empty.empty());
+        }
+        
+        void testAgainstStdSort()
+        {
+            ByteArray arena;
+            // Random data, sorted mostly by the first bytes
+            ccstAssertTrue(sortsLikeStdSort(makeRanges(arena, 5000, 20, 0xFF), 1));
+            // Small alphabet with many prefixes and duplicates
+            ccstAssertTrue(sortsLikeStdSort(makeRanges(arena, 20000, 12, 0x01), 1));
+            ccstAssertTrue(sortsLikeStdSort(makeRanges(arena, 20000, 3, 0x03), 1));
+            // Long common prefix
+            ccstAssertTrue(sortsLikeStdSort(makeRanges(arena, 3000, 10, 0x0F, 100), 1));
+            // Parallel sort
+            ccstAssertTrue(sortsLikeStdSort(makeRanges(arena, 100000, 16, 0xFF), 4));
+            ccstAssertTrue(sortsLikeStdSort(makeRanges(arena, 100000, 6, 0x81), 3));
+            ccstAssertTrue(sortsLikeStdSort(makeRanges(arena, 70000, 10, 0x07, 17), 0));
+        }
+        
+        /**
+         Creates |count| ranges sharing up to |prefix| bytes. The ranges are windows to the
+         arena, which contains |prefix| equal bytes followed by random data. So ranges have
+         both duplicates and different suffixes.
+         */
+        std::vector<ByteRange> makeLongPrefixRanges(ByteArray & arena, size_t count, size_t prefix)
+        {
+            ByteArray positions = getTestRandomData(count * 2);
+            arena.assign(prefix, 0x5A);
+            arena.append(getTestRandomData(64));
+            std::vector<ByteRange> ranges;
+            ranges.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                const size_t start  = positions[2 * i] & 0x0F;
+                const size_t suffix = positions[2 * i + 1] & 0x3F;
+                ranges.push_back(arena.byteRange().subRange(start, prefix - start + suffix));
+            }
+            return ranges;
+        }
+        
+        void testLongCommonPrefix()
+        {
+            // Identical long ranges
+            ByteArray arena(1024 * 1024, 0x5A);
+            std::vector<ByteRange> source(200, arena.byteRange());
+            ccstAssertTrue(sortsLikeStdSort(source, 1));
+            source.assign(200, arena.byteRange().subRange(0, 64 * 1024));
+            ccstAssertTrue(sortsLikeStdSort(source, 1));
+            std::vector<ByteRange> ranges(source);
+            SortAndUniqueByteRanges(ranges);
+            ccstAssertEqual(ranges.size(), 1);
+            // Long prefixes with duplicates and different suffixes
+            ccstAssertTrue(sortsLikeStdSort(makeLongPrefixRanges(arena, 2000, 256 * 1024), 1));
+            ccstAssertTrue(sortsLikeStdSort(makeLongPrefixRanges(arena, 70000, 1024), 4));
+        }
+        
+        void testUnique()
+        {
+            ByteArray arena;
+            std::vector<ByteRange> ranges = makeRanges(arena, 10000, 4, 0x03);
+            std::vector<ByteRange> expected(ranges);
+            std::sort(expected.begin(), expected.end());
+            expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+            SortAndUniqueByteRanges(ranges);
+            ccstAssertTrue(ranges == expected);
+            ccstAssertTrue(ranges.size() < 10000);
+            
+            ByteRange single("a");
+            ccstAssertEqual(UniqueByteRanges(&single, 1), 1);
+            ccstAssertEqual(UniqueByteRanges(nullptr, 0), 0);
+        }
+        
+        void testPerformance()
+        {
+            ByteArray arena;
+            std::vector<ByteRange> source = makeRanges(arena, 200000, 32, 0xFF);
+            std::vector<ByteRange> ranges(source);
+            PerformanceTimer timer;
+            std::sort(ranges.begin(), ranges.end());
+            double t_std = timer.elapsedTime();
+            
+            ranges = source;
+            timer.start();
+            SortByteRanges(ranges);
+            double t_radix = timer.elapsedTime();
+            
+            ranges = source;
+            timer.start();
+            SortByteRanges(ranges, 4);
+            double t_parallel = timer.elapsedTime();
+            
+            ccstMessage("Sort of %d ranges: std::sort %.3fms, SortByteRanges %.3fms, with 4 threads %.3fms",
+                        (int)source.size(), t_std, t_radix, t_parallel);
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7ByteRangeSortTests, "cc7")
+
+} // cc7::tests
+} // cc7
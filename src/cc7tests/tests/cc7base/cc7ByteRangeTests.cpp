@@ -17,6 +17,7 @@
 #include <cc7tests/CC7Tests.h>
 #include <cc7/ByteRange.h>
 #include <cc7/ByteArray.h>
+#include <algorithm>
 
 namespace cc7
 {
@@ -35,6 +36,12 @@ namespace tests
             CC7_REGISTER_TEST_METHOD(testCornerCases)
             CC7_REGISTER_TEST_METHOD(testSubRanges)
             CC7_REGISTER_TEST_METHOD(testOtherMethods)
+            CC7_REGISTER_TEST_METHOD(testSearch)
+            CC7_REGISTER_TEST_METHOD(testSearchRandom)
+            CC7_REGISTER_TEST_METHOD(testSplit)
+            CC7_REGISTER_TEST_METHOD(testEqualsConstantTime)
+            CC7_REGISTER_TEST_METHOD(testEqualsConstantTimeLeak)
+            CC7_REGISTER_TEST_METHOD(testTryMethods)
         }
         
         // Helper methods
@@ -324,6 +331,262 @@ namespace tests
             ByteRange r2;
             ccstAssertEqual(cc7::CopyToString(r2), "");
         }
+        
+        void testSearch()
+        {
+            ByteRange r1("Hello world! Hello again!");
+            ccstAssertEqual(r1.find('o'), 4);
+            ccstAssertEqual(r1.find('o', 5), 7);
+            ccstAssertEqual(r1.find('X'), ByteRange::npos);
+            ccstAssertEqual(r1.find('H', 100), ByteRange::npos);
+            ccstAssertEqual(r1.rfind('o'), 17);
+            ccstAssertEqual(r1.rfind('o', 16), 7);
+            ccstAssertEqual(r1.rfind('H', 0), 0);
+            ccstAssertEqual(r1.rfind('X'), ByteRange::npos);
+            
+            ccstAssertEqual(r1.find(ByteRange("Hello")), 0);
+            ccstAssertEqual(r1.find(ByteRange("Hello"), 1), 13);
+            ccstAssertEqual(r1.find(ByteRange("again!")), 19);
+            ccstAssertEqual(r1.find(ByteRange("again!!")), ByteRange::npos);
+            ccstAssertEqual(r1.find(ByteRange()), 0);
+            ccstAssertEqual(r1.find(ByteRange(), 5), 5);
+            ccstAssertEqual(r1.find(ByteRange(), 100), ByteRange::npos);
+            ccstAssertEqual(r1.rfind(ByteRange("Hello")), 13);
+            ccstAssertEqual(r1.rfind(ByteRange("Hello"), 12), 0);
+            ccstAssertEqual(r1.rfind(ByteRange("xyz")), ByteRange::npos);
+            ccstAssertEqual(r1.rfind(ByteRange()), r1.size());
+            
+            ccstAssertEqual(r1.find_first_of(ByteRange(" !")), 5);
+            ccstAssertEqual(r1.find_first_of(ByteRange("!"), 12), 24);
+            ccstAssertEqual(r1.find_first_of(ByteRange("xyz")), ByteRange::npos);
+            ccstAssertEqual(r1.find_first_of(ByteRange()), ByteRange::npos);
+            
+            ccstAssertTrue(r1.startsWith(ByteRange("Hello")));
+            ccstAssertTrue(r1.startsWith(ByteRange()));
+            ccstAssertFalse(r1.startsWith(ByteRange("world")));
+            ccstAssertTrue(r1.endsWith(ByteRange("again!")));
+            ccstAssertFalse(r1.endsWith(ByteRange("Hello")));
+            ccstAssertFalse(ByteRange("ab").endsWith(ByteRange("abc")));
+            
+            // Empty range
+            ByteRange r2;
+            ccstAssertEqual(r2.find('a'), ByteRange::npos);
+            ccstAssertEqual(r2.rfind('a'), ByteRange::npos);
+            ccstAssertEqual(r2.find(ByteRange("a")), ByteRange::npos);
+            ccstAssertEqual(r2.find(ByteRange()), 0);
+            ccstAssertEqual(r2.find_first_of(ByteRange("ab")), ByteRange::npos);
+            ccstAssertTrue(r2.startsWith(ByteRange()));
+        }
+        
+        void testSearchRandom()
+        {
+            // Compare with std::string, on data with a small alphabet
+            ByteArray data = getTestRandomData(2000);
+            for (auto & b : data) {
+                b = 'a' + (b & 3);
+            }
+            std::string str = CopyToString(data);
+            ByteRange range = data.byteRange();
+            bool equal = true;
+            for (size_t needle_size = 1; needle_size < 40 && equal; needle_size += 3) {
+                for (size_t offset = 0; offset + needle_size <= 300 && equal; offset += 17) {
+                    std::string needle = str.substr(offset * 5, needle_size);
+                    ByteRange needle_range(needle);
+                    for (size_t pos = 0; pos < str.size() && equal; pos += 391) {
+                        equal = range.find(needle_range, pos) == str.find(needle, pos) &&
+                                range.rfind(needle_range, str.size() - pos) == str.rfind(needle, str.size() - pos) &&
+                                range.find_first_of(needle_range, pos) == str.find_first_of(needle, pos);
+                    }
+                }
+            }
+            ccstAssertTrue(equal);
+            // Needle at the very end of data
+            ccstAssertEqual(range.find(range.subRangeFrom(1990)), str.find(str.substr(1990)));
+            ccstAssertEqual(range.find(range), 0);
+        }
+        
+        void testSplit()
+        {
+            std::vector<std::string> parts;
+            for (ByteRange part : ByteRange("a,,bc,").split(',')) {
+                parts.push_back(CopyToString(part));
+            }
+            ccstAssertEqual(parts.size(), 4);
+            ccstAssertEqual(parts[0], "a");
+            ccstAssertEqual(parts[1], "");
+            ccstAssertEqual(parts[2], "bc");
+            ccstAssertEqual(parts[3], "");
+            
+            parts.clear();
+            ByteRange data("GET / HTTP/1.1\r\nHost: x\r\n\r\nbody");
+            for (ByteRange part : data.split(ByteRange("\r\n"))) {
+                ccstAssertTrue(part.empty() || (part.data() >= data.data() && part.data() + part.size() <= data.data() + data.size()));
+                parts.push_back(CopyToString(part));
+            }
+            ccstAssertEqual(parts.size(), 4);
+            ccstAssertEqual(parts[0], "GET / HTTP/1.1");
+            ccstAssertEqual(parts[1], "Host: x");
+            ccstAssertEqual(parts[2], "");
+            ccstAssertEqual(parts[3], "body");
+            
+            // No delimiter, empty range and empty delimiter produce one range
+            size_t count = 0;
+            for (ByteRange part : ByteRange("abc").split(';')) {
+                ccstAssertEqual(part, ByteRange("abc"));
+                count++;
+            }
+            ccstAssertEqual(count, 1);
+            ByteRangeSplit split = ByteRange().split(',');
+            ccstAssertEqual(std::distance(split.begin(), split.end()), 1);
+            ccstAssertTrue(split.begin()->empty());
+            ByteRangeSplit split2 = ByteRange("a,b").split(ByteRange());
+            ccstAssertEqual(std::distance(split2.begin(), split2.end()), 1);
+        }
+        
+        void testEqualsConstantTime()
+        {
+            ByteArray data = getTestRandomData(300);
+            for (size_t length = 0; length <= data.size(); length++) {
+                ByteArray a(data.byteRange().subRangeTo(length));
+                ByteArray b(a);
+                ccstAssertTrue(a.byteRange().equalsConstantTime(b));
+                ccstAssertTrue(EqualsConstantTime(a, b));
+                // Difference at every position
+                bool all_detected = true;
+                for (size_t i = 0; i < length; i++) {
+                    b[i] ^= 0x80;
+                    all_detected &= !EqualsConstantTime(a, b);
+                    b[i] ^= 0x80;
+                }
+                ccstAssertTrue(all_detected, "Length %d", (int)length);
+            }
+            ccstAssertTrue(EqualsConstantTime(ByteRange(), ByteRange()));
+            ccstAssertFalse(EqualsConstantTime(ByteRange("abc"), ByteRange("abcd")));
+            ccstAssertFalse(EqualsConstantTime(ByteRange("abcd"), ByteRange("abc")));
+        }
+        
+        /**
+         Returns median time of |rounds| measurements of |iterations| comparisons.
+         */
+        static double measureComparison(const ByteRange & a, const ByteRange & b, bool constant_time, size_t rounds, size_t iterations, std::vector<double> & samples)
+        {
+            PerformanceTimer timer;
+            volatile bool result = false;
+            samples.clear();
+            for (size_t r = 0; r < rounds; r++) {
+                timer.start();
+                for (size_t i = 0; i < iterations; i++) {
+                    result = constant_time ? EqualsConstantTime(a, b) : (a == b);
+                }
+                samples.push_back(timer.elapsedTime());
+            }
+            (void)result;
+            std::sort(samples.begin(), samples.end());
+            return samples[samples.size() / 2];
+        }
+        
+        void testEqualsConstantTimeLeak()
+        {
+            const size_t size = 4096;
+            ByteArray a = getTestRandomData(size);
+            ByteArray equal(a);
+            ByteArray differ_first(a);
+            differ_first[0] ^= 1;
+            ByteArray differ_last(a);
+            differ_last[size - 1] ^= 1;
+            
+            // Interleave measurements for the equal and different inputs, so the
+            // noise from the system affects all of them. Then compare the medians.
+            std::vector<double> samples;
+            double t_equal = 0, t_first = 0, t_last = 0;
+            for (int pass = 0; pass < 5; pass++) {
+                t_equal += measureComparison(a, equal, true, 21, 200, samples);
+                t_first += measureComparison(a, differ_first, true, 21, 200, samples);
+                t_last  += measureComparison(a, differ_last, true, 21, 200, samples);
+            }
+            const double ratio_first = t_first / t_equal;
+            const double ratio_last  = t_last / t_equal;
+            ccstMessage("EqualsConstantTime: %d bytes, equal %.3fms, differs at first %.3fms (ratio %.2f), differs at last %.3fms (ratio %.2f)",
+                        (int)size, t_equal, t_first, ratio_first, t_last, ratio_last);
+            // memcmp() on data with difference at the first byte is typically 100x faster.
+            // Allow a big tolerance, to not fail on a busy machine.
+            ccstAssertTrue(ratio_first > 0.5 && ratio_first < 2.0);
+            ccstAssertTrue(ratio_last > 0.5 && ratio_last < 2.0);
+            
+            // Benchmark against memcmp based comparison and a byte-by-byte loop.
+            double t_memcmp = measureComparison(a, equal, false, 11, 200, samples);
+            PerformanceTimer timer;
+            volatile bool result = false;
+            for (size_t i = 0; i < 200; i++) {
+                cc7::byte diff = 0;
+                for (size_t j = 0; j < size; j++) {
+                    diff |= a[j] ^ equal[j];
+                }
+                result = diff == 0;
+            }
+            (void)result;
+            double t_loop = timer.elapsedTime();
+            ccstMessage("Comparison of 200 x %d bytes: EqualsConstantTime %.3fms, memcmp %.3fms, byte loop %.3fms",
+                        (int)size, t_equal / 5, t_memcmp, t_loop);
+        }
+        
+        void testTryMethods()
+        {
+            const ByteRange source("Hello world!");
+            ByteRange r = source;
+            ByteRange out("unchanged");
+            
+            ccstAssertTrue(r.trySubRange(6, 5, out));
+            ccstAssertEqual(out, ByteRange("world"));
+            ccstAssertTrue(r.trySubRange(12, 0, out));
+            ccstAssertTrue(out.empty());
+            out = ByteRange("unchanged");
+            ccstAssertFalse(r.trySubRange(6, 7, out));
+            ccstAssertFalse(r.trySubRange(13, 0, out));
+            ccstAssertFalse(r.trySubRange(1, ByteRange::npos, out));   // overflow
+            ccstAssertEqual(out, ByteRange("unchanged"));
+            
+            ccstAssertTrue(r.trySubRangeFrom(6, out));
+            ccstAssertEqual(out, ByteRange("world!"));
+            ccstAssertFalse(r.trySubRangeFrom(13, out));
+            ccstAssertTrue(r.trySubRangeTo(5, out));
+            ccstAssertEqual(out, ByteRange("Hello"));
+            ccstAssertFalse(r.trySubRangeTo(13, out));
+            ccstAssertEqual(out, ByteRange("Hello"));
+            
+            cc7::byte b = 0;
+            ccstAssertTrue(r.tryAt(11, b));
+            ccstAssertEqual(b, '!');
+            ccstAssertFalse(r.tryAt(12, b));
+            ccstAssertEqual(b, '!');
+            
+            ccstAssertFalse(r.tryRemovePrefix(13));
+            ccstAssertFalse(r.tryRemoveSuffix(13));
+            ccstAssertEqual(r, source);
+            ccstAssertTrue(r.tryRemovePrefix(6));
+            ccstAssertTrue(r.tryRemoveSuffix(1));
+            ccstAssertEqual(r, ByteRange("world"));
+            
+            ByteRange prefix;
+            ccstAssertTrue(r.tryPopPrefix(3, prefix));
+            ccstAssertEqual(prefix, ByteRange("wor"));
+            ccstAssertEqual(r, ByteRange("ld"));
+            ccstAssertFalse(r.tryPopPrefix(3, prefix));
+            ccstAssertEqual(prefix, ByteRange("wor"));
+            ccstAssertTrue(r.tryPopPrefix(2, prefix));
+            ccstAssertTrue(r.empty());
+            
+            // Empty range
+            ByteRange empty;
+            ccstAssertTrue(empty.tryRemovePrefix(0));
+            ccstAssertTrue(empty.trySubRange(0, 0, out));
+            ccstAssertTrue(out.empty());
+            ccstAssertFalse(empty.tryAt(0, b));
+            ccstAssertFalse(empty.tryRemoveSuffix(1));
+            
+            static_assert(noexcept(empty.trySubRange(0, 0, out)), "trySubRange must be noexcept");
+            static_assert(noexcept(empty.tryRemovePrefix(0)), "tryRemovePrefix must be noexcept");
+        }
     };
     
     CC7_CREATE_UNIT_TEST(cc7ByteRangeTests, "cc7")
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/ByteWriter.h>
+#include <cc7/ByteReader.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7ByteReaderWriterTests : public UnitTest
+    {
+    public:
+        cc7ByteReaderWriterTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testWriter)
+            CC7_REGISTER_TEST_METHOD(testReader)
+            CC7_REGISTER_TEST_METHOD(testBulk)
+            CC7_REGISTER_TEST_METHOD(testWriteOwnContent)
+            CC7_REGISTER_TEST_METHOD(testRoundTrip)
+        }
+
+        // Unit tests
+
+        void testWriter()
+        {
+            ByteArray data = { 0xEE };
+            {
+                ByteWriter writer(data, 8);
+                writer.writeByte(0x01)
+                    .writeU16(0x0203)
+                    .writeU32(0x04050607)
+                    .writeU64(0x08090A0B0C0D0E0FULL)
+                    .writeU16LE(0x0201)
+                    .writeU32LE(0x06050403);
+                ccstAssertEqual(writer.size(), 1 + 2 + 4 + 8 + 2 + 4);
+            }
+            ccstAssertEqual(data, ByteArray({ 0xEE,
+                0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                0x01, 0x02, 0x03, 0x04, 0x05, 0x06 }));
+
+            data.clear();
+            {
+                ByteWriter writer(data);
+                writer.block(5)
+                    .putByte(0xAA)
+                    .putBigEndian<U16>(0x1122)
+                    .putLittleEndian<U16>(0x1122);
+                writer.writeLengthPrefixed<U8>(ByteRange("abc"));
+                writer.writeLengthPrefixed<U16>(ByteRange());
+                writer.finish();
+                ccstAssertEqual(data.size(), 5 + 4 + 2);
+            }
+            ccstAssertEqual(data, ByteArray({ 0xAA, 0x11, 0x22, 0x22, 0x11, 3, 'a', 'b', 'c', 0, 0 }));
+
+#if !defined(CC7_NO_EXCEPTIONS)
+            bool exception = false;
+            try {
+                ByteWriter writer(data);
+                writer.writeLengthPrefixed<U8>(ByteArray(256, 0));
+            } catch (std::length_error &) {
+                exception = true;
+            }
+            ccstAssertTrue(exception);
+            ccstAssertEqual(data.size(), 11);
+#endif
+        }
+
+        void testReader()
+        {
+            ByteArray data = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x00, 0x03, 'a', 'b', 'c', 0x05, 'x' };
+            ByteReader reader(data);
+            cc7::byte b;
+            U16 u16;
+            U32 u32;
+            ccstAssertTrue(reader.readByte(b));
+            ccstAssertEqual(b, 0x01);
+            ccstAssertTrue(reader.readU16(u16));
+            ccstAssertEqual(u16, 0x0203);
+            ccstAssertTrue(reader.readU32LE(u32));
+            ccstAssertEqual(u32, 0x07060504);
+            ccstAssertEqual(reader.offset(), 7);
+
+            ByteRange str;
+            ccstAssertTrue(reader.readLengthPrefixed<U16>(str));
+            ccstAssertEqual(CopyToString(str), "abc");
+            ccstAssertEqual(str.data(), data.data() + 9);
+
+            // Incomplete sequence doesn't move the position
+            ccstAssertFalse(reader.readLengthPrefixed<U8>(str));
+            ccstAssertFalse(reader.readU32(u32));
+            ccstAssertEqual(reader.remaining(), 2);
+            ccstAssertTrue(reader.skip(1));
+            ccstAssertFalse(reader.readBytes(2, str));
+            ccstAssertTrue(reader.readBytes(1, str));
+            ccstAssertEqual(CopyToString(str), "x");
+            ccstAssertTrue(reader.atEnd());
+            ccstAssertFalse(reader.readByte(b));
+
+            ByteReader reader2(data);
+            ByteReader::Block block;
+            ccstAssertFalse(reader2.block(data.size() + 1, block));
+            ccstAssertTrue(reader2.block(7, block));
+            ccstAssertEqual(block.getByte(), 0x01);
+            ccstAssertEqual(block.getLittleEndian<U16>(), 0x0302);
+            ccstAssertEqual(block.getBigEndian<U32>(), 0x04050607);
+            ccstAssertEqual(block.remaining(), 0);
+            ccstAssertEqual(reader2.remainingRange(), data.byteRange().subRangeFrom(7));
+        }
+
+        void testBulk()
+        {
+            const U32 values[] = { 0x01020304, 0xA0B0C0D0, 0xFFFFFFFF, 0 };
+            ByteArray data;
+            {
+                ByteWriter writer(data);
+                writer.writeBigEndian(values, 4);
+                writer.writeLittleEndian(values, 4);
+            }
+            ccstAssertEqual(data.size(), 32);
+            ccstAssertEqual(data.byteRange().subRange(0, 4), ByteArray({ 1, 2, 3, 4 }));
+            ccstAssertEqual(data.byteRange().subRange(16, 4), ByteArray({ 4, 3, 2, 1 }));
+
+            U32 be[4], le[4];
+            ByteReader reader(data);
+            ccstAssertTrue(reader.readBigEndian(be, 4));
+            ccstAssertTrue(reader.readLittleEndian(le, 4));
+            ccstAssertFalse(reader.readBigEndian(be, 1));
+            for (size_t i = 0; i < 4; i++) {
+                ccstAssertEqual(be[i], values[i]);
+                ccstAssertEqual(le[i], values[i]);
+            }
+        }
+
+        void testWriteOwnContent()
+        {
+            // The target array is reallocated while its own content is written
+            const ByteArray source = getTestRandomData(100);
+            ByteArray data(source);
+            {
+                ByteWriter writer(data);
+                writer.writeBytes(data.byteRange());
+                writer.writeLengthPrefixed<U8>(data.byteRange().subRange(10, 20));
+                const U16 * values = reinterpret_cast<const U16*>(data.data());
+                writer.writeLittleEndian<U16>(values, 50);
+            }
+            ByteArray expected(source);
+            expected.append(source);
+            expected.append(20);
+            expected.append(source.byteRange().subRange(10, 20));
+            expected.append(source);
+            ccstAssertEqual(data, expected);
+        }
+        
+        void testRoundTrip()
+        {
+            ByteArray data;
+            ByteArray payload = getTestRandomData(1000);
+            {
+                ByteWriter writer(data);
+                for (U32 i = 0; i < 1000; i++) {
+                    writer.writeU32(i);
+                    writer.writeU64LE((U64)i << 32);
+                    writer.writeLengthPrefixed<U16>(payload.byteRange().subRange(0, i));
+                }
+            }
+            ByteReader reader(data);
+            bool success = true;
+            for (U32 i = 0; i < 1000 && success; i++) {
+                U32 v32;
+                U64 v64;
+                ByteRange r;
+                success = reader.readU32(v32) && reader.readU64LE(v64) && reader.readLengthPrefixed<U16>(r);
+                success = success && v32 == i && v64 == ((U64)i << 32) && r == payload.byteRange().subRange(0, i);
+            }
+            ccstAssertTrue(success);
+            ccstAssertTrue(reader.atEnd());
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7ByteReaderWriterTests, "cc7")
+
+} // cc7::tests
+} // cc7
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/Checksum.h>
+#include <cc7/ByteChain.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7ChecksumTests : public UnitTest
+    {
+    public:
+        cc7ChecksumTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testKnownValues)
+            CC7_REGISTER_TEST_METHOD(testAgainstReference)
+            CC7_REGISTER_TEST_METHOD(testTableAgainstReference)
+            CC7_REGISTER_TEST_METHOD(testUpdateAndCombine)
+            CC7_REGISTER_TEST_METHOD(testByteChain)
+        }
+
+        // Reference implementations
+
+        static U32 referenceCrc(U32 poly, const ByteRange & data)
+        {
+            U32 crc = 0xFFFFFFFF;
+            for (cc7::byte b : data) {
+                crc ^= b;
+                for (int k = 0; k < 8; k++) {
+                    crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+                }
+            }
+            return ~crc;
+        }
+
+        static U32 referenceAdler32(const ByteRange & data)
+        {
+            U32 s1 = 1, s2 = 0;
+            for (cc7::byte b : data) {
+                s1 = (s1 + b) % 65521;
+                s2 = (s2 + s1) % 65521;
+            }
+            return s1 | (s2 << 16);
+        }
+
+        // Unit tests
+
+        void testKnownValues()
+        {
+            ByteRange check("123456789");
+            ccstAssertEqual(CRC32_Calculate(check),  0xCBF43926);
+            ccstAssertEqual(CRC32C_Calculate(check), 0xE3069283);
+            ccstAssertEqual(Adler32_Calculate(ByteRange("Wikipedia")), 0x11E60398);
+
+            ccstAssertEqual(CRC32_Calculate(ByteRange()),   0);
+            ccstAssertEqual(CRC32C_Calculate(ByteRange()),  0);
+            ccstAssertEqual(Adler32_Calculate(ByteRange()), 1);
+
+            ByteRange fox("The quick brown fox jumps over the lazy dog");
+            ccstAssertEqual(CRC32_Calculate(fox),   0x414FA339);
+            ccstAssertEqual(CRC32C_Calculate(fox),  0x22620404);
+            ccstAssertEqual(Adler32_Calculate(fox), 0x5BDC0FDA);
+
+            // All 0xFF bytes, maximizes sums in Adler32
+            ByteArray ff(100000, 0xFF);
+            ccstAssertEqual(Adler32_Calculate(ff), referenceAdler32(ff));
+        }
+
+        void testAgainstReference()
+        {
+            checkAgainstReference();
+        }
+
+        void testTableAgainstReference()
+        {
+            // The accelerated implementation is selected on most CPUs, so test the tables explicitly.
+            cc7::detail::Checksum_ForceTableImplementation(true);
+            checkAgainstReference();
+            cc7::detail::Checksum_ForceTableImplementation(false);
+        }
+
+        void checkAgainstReference()
+        {
+            ByteArray data = getTestRandomData(20000);
+            bool crc32_equal = true, crc32c_equal = true, adler_equal = true;
+            for (size_t offset = 0; offset < 4; offset++) {
+                for (size_t length = 0; length < 300; length++) {
+                    ByteRange range = data.byteRange().subRange(offset, length);
+                    crc32_equal  &= CRC32_Calculate(range)   == referenceCrc(0xEDB88320, range);
+                    crc32c_equal &= CRC32C_Calculate(range)  == referenceCrc(0x82F63B78, range);
+                    adler_equal  &= Adler32_Calculate(range) == referenceAdler32(range);
+                }
+            }
+            for (size_t length : { 3071, 3072, 3073, 6150, 11111, 19999 }) {
+                ByteRange range = data.byteRange().subRange(1, length);
+                crc32_equal  &= CRC32_Calculate(range)   == referenceCrc(0xEDB88320, range);
+                crc32c_equal &= CRC32C_Calculate(range)  == referenceCrc(0x82F63B78, range);
+                adler_equal  &= Adler32_Calculate(range) == referenceAdler32(range);
+            }
+            ccstAssertTrue(crc32_equal);
+            ccstAssertTrue(crc32c_equal);
+            ccstAssertTrue(adler_equal);
+        }
+
+        void testUpdateAndCombine()
+        {
+            ByteArray data = getTestRandomData(10000);
+            const U32 crc32   = CRC32_Calculate(data);
+            const U32 crc32c  = CRC32C_Calculate(data);
+            const U32 adler32 = Adler32_Calculate(data);
+            for (size_t split : { 0, 1, 15, 64, 1000, 3333, 9999, 10000 }) {
+                ByteRange a = data.byteRange().subRangeTo(split);
+                ByteRange b = data.byteRange().subRangeFrom(split);
+                ccstAssertEqual(CRC32_Update(CRC32_Calculate(a), b), crc32);
+                ccstAssertEqual(CRC32C_Update(CRC32C_Calculate(a), b), crc32c);
+                ccstAssertEqual(Adler32_Update(Adler32_Calculate(a), b), adler32);
+                ccstAssertEqual(CRC32_Combine(CRC32_Calculate(a), CRC32_Calculate(b), b.size()), crc32);
+                ccstAssertEqual(CRC32C_Combine(CRC32C_Calculate(a), CRC32C_Calculate(b), b.size()), crc32c);
+                ccstAssertEqual(Adler32_Combine(Adler32_Calculate(a), Adler32_Calculate(b), b.size()), adler32);
+            }
+            // Combine with a long virtual block of zeros
+            ByteArray zeros(100000, 0);
+            const U32 crc_a = CRC32_Calculate(data);
+            ccstAssertEqual(CRC32_Combine(crc_a, CRC32_Calculate(zeros), zeros.size()), CRC32_Update(crc_a, zeros));
+            ccstAssertEqual(Adler32_Combine(adler32, Adler32_Calculate(zeros), zeros.size()), Adler32_Update(adler32, zeros));
+        }
+
+        void testByteChain()
+        {
+            ByteArray data = getTestRandomData(5000);
+            ByteChain chain;
+            chain.appendBorrowed(data.byteRange().subRange(0, 7));
+            chain.appendBorrowed(data.byteRange().subRange(7, 1000));
+            chain.appendBorrowed(data.byteRange().subRange(1007, 0));
+            chain.appendBorrowed(data.byteRange().subRangeFrom(1007));
+            ccstAssertEqual(CRC32_Calculate(chain),   CRC32_Calculate(data));
+            ccstAssertEqual(CRC32C_Calculate(chain),  CRC32C_Calculate(data));
+            ccstAssertEqual(Adler32_Calculate(chain), Adler32_Calculate(data));
+            ccstAssertEqual(CRC32_Calculate(ByteChain()), 0);
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7ChecksumTests, "cc7")
+
+} // cc7::tests
+} // cc7
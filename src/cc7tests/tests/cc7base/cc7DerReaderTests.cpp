@@ -0,0 +1,197 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/DerReader.h>
+#include <cc7/HexString.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7DerReaderTests : public UnitTest
+    {
+    public:
+        cc7DerReaderTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testStructure)
+            CC7_REGISTER_TEST_METHOD(testLengthsAndTags)
+            CC7_REGISTER_TEST_METHOD(testMalformed)
+        }
+
+        // Unit tests
+
+        void testStructure()
+        {
+            ByteArray data = FromHexString(
+                "3024"
+                "020101"                // INTEGER 1
+                "020200FF"              // INTEGER 255
+                "0500"                  // NULL
+                "0101FF"                // BOOLEAN TRUE
+                "06062A864886F70D"      // OID 1.2.840.113549
+                "0403616263"            // OCTET STRING "abc"
+                "030204F0"              // BIT STRING, 4 unused bits
+                "A003020102"            // [0] EXPLICIT INTEGER 2
+                "3100"                  // SET {}
+            );
+            DerReader reader(data);
+            DerReader seq;
+            ccstAssertTrue(reader.readSequence(seq));
+            ccstAssertTrue(reader.atEnd());
+            ccstAssertEqual(seq.remaining(), 0x24);
+            
+            U64 value;
+            bool flag = false;
+            ccstAssertFalse(seq.readBoolean(flag));     // wrong type, position is not changed
+            ccstAssertTrue(seq.readInteger(value));
+            ccstAssertEqual(value, 1);
+            ByteRange int_bytes;
+            ccstAssertTrue(seq.nextHasIdentifier(DER_INTEGER));
+            ccstAssertTrue(seq.readIntegerBytes(int_bytes));
+            ccstAssertEqual(int_bytes.data(), data.data() + 7);    // points to source data
+            ccstAssertEqual(int_bytes, FromHexString("00FF"));
+            ccstAssertTrue(seq.readNull());
+            ccstAssertTrue(seq.readBoolean(flag));
+            ccstAssertTrue(flag);
+            ByteRange oid;
+            ccstAssertTrue(seq.readObjectIdentifier(oid));
+            ccstAssertEqual(oid, FromHexString("2A864886F70D"));
+            ByteRange octets;
+            ccstAssertTrue(seq.readOctetString(octets));
+            ccstAssertEqual(octets, ByteRange("abc"));
+            ByteRange bits;
+            cc7::byte unused_bits;
+            ccstAssertTrue(seq.readBitString(bits, unused_bits));
+            ccstAssertEqual(bits.size(), 1);
+            ccstAssertEqual(unused_bits, 4);
+            
+            DerElement element;
+            ccstAssertTrue(seq.peek(element));
+            ccstAssertEqual(element.tag_class, DerElement::ContextSpecific);
+            ccstAssertTrue(element.constructed);
+            ccstAssertEqual(element.tag_number, 0);
+            ccstAssertEqual(element.encoded.size(), 5);
+            DerReader explicit_reader;
+            ccstAssertFalse(seq.enter(DER_ContextTag(1, true), explicit_reader));
+            ccstAssertTrue(seq.enter(DER_ContextTag(0, true), explicit_reader));
+            ccstAssertTrue(explicit_reader.readInteger(value));
+            ccstAssertEqual(value, 2);
+            ccstAssertTrue(explicit_reader.atEnd());
+            
+            ccstAssertFalse(seq.skipIf(DER_SEQUENCE));
+            DerReader set;
+            ccstAssertTrue(seq.readSet(set));
+            ccstAssertTrue(set.atEnd());
+            ccstAssertTrue(seq.atEnd());
+            ccstAssertFalse(seq.skip());
+            
+            // Iterate over all children
+            ccstAssertTrue(DerReader(data).readSequence(seq));
+            size_t count = 0;
+            while (seq.read(element)) {
+                count++;
+            }
+            ccstAssertEqual(count, 9);
+            ccstAssertTrue(seq.atEnd());
+        }
+        
+        void testLengthsAndTags()
+        {
+            // Long form length
+            ByteArray data = FromHexString("048180");
+            data.append(ByteArray(0x80, 0xAB));
+            data.append(FromHexString("9F1F00"));        // [31] with empty value
+            data.append(FromHexString("5F8101020506"));  // [APPLICATION 129] primitive
+            DerReader reader(data);
+            ByteRange value;
+            ccstAssertTrue(reader.readOctetString(value));
+            ccstAssertEqual(value.size(), 0x80);
+            ccstAssertEqual(value.data(), data.data() + 3);
+            DerElement element;
+            ccstAssertTrue(reader.read(element));
+            ccstAssertEqual(element.tag_class, DerElement::ContextSpecific);
+            ccstAssertEqual(element.tag_number, 31);
+            ccstAssertFalse(element.constructed);
+            ccstAssertTrue(element.value.empty());
+            ccstAssertTrue(reader.read(element));
+            ccstAssertEqual(element.tag_class, DerElement::Application);
+            ccstAssertEqual(element.tag_number, 129);
+            ccstAssertEqual(element.value, FromHexString("0506"));
+            ccstAssertTrue(reader.atEnd());
+            
+            // Big non-negative integer with leading zero
+            U64 number;
+            ccstAssertTrue(DerReader(FromHexString("020900FFFFFFFFFFFFFFFF")).readInteger(number));
+            ccstAssertEqual(number, 0xFFFFFFFFFFFFFFFFULL);
+            ByteRange int_bytes;
+            ccstAssertTrue(DerReader(FromHexString("0201FF")).readIntegerBytes(int_bytes));  // -1
+            
+            // Empty reader
+            DerReader empty;
+            ccstAssertTrue(empty.atEnd());
+            ccstAssertFalse(empty.read(element));
+        }
+        
+        void testMalformed()
+        {
+            const char * malformed[] = {
+                "30800201010000",      // indefinite length
+                "0481056162636465",    // non-minimal long form
+                "04820080",             // leading zero in length
+                "0405616263",           // truncated value
+                "04",                   // missing length
+                "0481",                 // truncated length
+                "1F0500",               // low tag number in high form
+                "1F801F00",             // leading zero group in tag
+                "1F",                   // truncated tag
+                "3F9F8F8F8F0F00",       // tag number too big
+            };
+            for (const char * hex : malformed) {
+                ByteArray data = FromHexString(hex);
+                DerReader reader(data);
+                DerElement element;
+                ccstAssertFalse(reader.peek(element), "%s", hex);
+                ccstAssertFalse(reader.read(element), "%s", hex);
+                ccstAssertFalse(reader.skip(), "%s", hex);
+                ccstAssertEqual(reader.offset(), 0);
+            }
+            
+            U64 number;
+            ByteRange range;
+            bool flag;
+            cc7::byte unused;
+            ccstAssertFalse(DerReader(FromHexString("02020001")).readIntegerBytes(range));    // non-minimal
+            ccstAssertFalse(DerReader(FromHexString("0202FF80")).readIntegerBytes(range));    // non-minimal negative
+            ccstAssertFalse(DerReader(FromHexString("0200")).readIntegerBytes(range));        // empty
+            ccstAssertFalse(DerReader(FromHexString("020180")).readInteger(number));          // negative
+            ccstAssertFalse(DerReader(FromHexString("0209010000000000000000")).readInteger(number));  // too big
+            ccstAssertFalse(DerReader(FromHexString("010101")).readBoolean(flag));            // not DER boolean
+            ccstAssertFalse(DerReader(FromHexString("050100")).readNull());
+            ccstAssertFalse(DerReader(FromHexString("03020FF1")).readBitString(range, unused));  // too many unused bits
+            ccstAssertFalse(DerReader(FromHexString("030204F1")).readBitString(range, unused));  // unused bits not zero
+            ccstAssertFalse(DerReader(FromHexString("030101")).readBitString(range, unused));    // empty with unused bits
+            ccstAssertFalse(DerReader(FromHexString("06028001")).readObjectIdentifier(range));  // leading zero group
+            ccstAssertFalse(DerReader(FromHexString("06022A86")).readObjectIdentifier(range));  // incomplete sub-identifier
+            DerReader reader;
+            ccstAssertFalse(DerReader(FromHexString("1000")).enter(0x10, reader));            // not constructed
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7DerReaderTests, "cc7")
+
+} // cc7::tests
+} // cc7
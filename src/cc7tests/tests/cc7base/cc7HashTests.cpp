@@ -0,0 +1,128 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/Hash.h>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7HashTests : public UnitTest
+    {
+    public:
+        cc7HashTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testDistribution)
+            CC7_REGISTER_TEST_METHOD(testSeed)
+            CC7_REGISTER_TEST_METHOD(testStdHash)
+        }
+
+        // Unit tests
+
+        void testDistribution()
+        {
+            ByteArray data = getTestRandomData(1024);
+            std::unordered_set<U64> hashes;
+            size_t count = 0;
+            // Every prefix and every one-byte change must produce a different hash.
+            for (size_t length = 0; length <= 200; length++) {
+                ByteRange range = data.byteRange().subRangeTo(length);
+                U64 hash = Hash64(range);
+                ccstAssertEqual(hash, Hash64(ByteArray(range)));
+                hashes.insert(hash);
+                count++;
+                ByteArray modified(range);
+                for (size_t i = 0; i < length; i += 7) {
+                    modified[i] ^= 0x01;
+                    hashes.insert(Hash64(modified));
+                    modified[i] ^= 0x01;
+                    count++;
+                }
+            }
+            ccstAssertEqual(hashes.size(), count);
+            
+            // All zero inputs with different lengths
+            ByteArray zeros(100);
+            hashes.clear();
+            for (size_t length = 0; length <= zeros.size(); length++) {
+                hashes.insert(Hash64(zeros.byteRange().subRangeTo(length)));
+            }
+            ccstAssertEqual(hashes.size(), zeros.size() + 1);
+            
+            // Avalanche, flipping one bit should change roughly half of the output bits
+            ByteArray key = getTestRandomData(40);
+            U64 hash = Hash64(key);
+            size_t total_bits = 0;
+            for (size_t bit = 0; bit < key.size() * 8; bit++) {
+                key[bit >> 3] ^= (1 << (bit & 7));
+                U64 diff = hash ^ Hash64(key);
+                key[bit >> 3] ^= (1 << (bit & 7));
+                for (; diff; diff &= diff - 1) {
+                    total_bits++;
+                }
+            }
+            const size_t average = total_bits / (key.size() * 8);
+            ccstAssertTrue(average > 24 && average < 40);
+        }
+        
+        void testSeed()
+        {
+            ByteArray data = getTestRandomData(100);
+            for (size_t length : { 0, 3, 8, 16, 17, 48, 49, 100 }) {
+                ByteRange range = data.byteRange().subRangeTo(length);
+                ccstAssertEqual(Hash64(range, 1234), Hash64(range, 1234));
+                ccstAssertNotEqual(Hash64(range, 1234), Hash64(range, 1235));
+                ccstAssertNotEqual(Hash64(range), Hash64(range, 1));
+                ccstAssertEqual(ByteRangeHash(77)(range), (size_t)Hash64(range, 77));
+            }
+        }
+        
+        void testStdHash()
+        {
+            ByteArray a1 = { 1, 2, 3, 4, 5 };
+            ByteRange r1 = a1.byteRange();
+            ccstAssertEqual(std::hash<ByteArray>()(a1), std::hash<ByteRange>()(r1));
+            ccstAssertEqual(std::hash<ByteRange>()(r1), ByteRangeHash()(a1));
+            ccstAssertTrue(ByteRangeEqual()(a1, r1));
+            ccstAssertFalse(ByteRangeEqual()(a1, r1.subRangeFrom(1)));
+            
+            std::unordered_map<ByteArray, int> map;
+            for (int i = 0; i < 1000; i++) {
+                map[getTestRandomData(1 + i % 40)] = i;
+            }
+            map[a1] = -1;
+            ccstAssertEqual(map[ByteArray({ 1, 2, 3, 4, 5 })], -1);
+            
+            std::unordered_map<ByteArray, int, ByteRangeHash, ByteRangeEqual> seeded_map(16, ByteRangeHash(0x5eed));
+            seeded_map[a1] = 1;
+            ccstAssertEqual(seeded_map.count(a1), 1);
+            ccstAssertEqual(seeded_map.hash_function().seed(), 0x5eed);
+            
+            std::unordered_set<ByteRange> set;
+            set.insert(r1);
+            set.insert(r1.subRangeTo(2));
+            set.insert(ByteRange(a1.data(), 2));
+            ccstAssertEqual(set.size(), 2);
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7HashTests, "cc7")
+
+} // cc7::tests
+} // cc7
@@ -69,6 +69,18 @@ namespace tests
                 ccstAssertTrue(result);
                 ccstAssertEqualMemSize(d.data(), data, s / 2);
                 
+                // Decode to the buffer
+                byte buffer[sizeof(data)];
+                size_t buffer_size;
+                result = HexString_Decode(hex, MutableByteRange(buffer, s / 2), buffer_size);
+                ccstAssertTrue(result);
+                ccstAssertEqual(buffer_size, s / 2);
+                ccstAssertEqualMemSize(buffer, data, s / 2);
+                if (s > 0) {
+                    result = HexString_Decode(hex, MutableByteRange(buffer, s / 2 - 1), buffer_size);
+                    ccstAssertFalse(result);
+                }
+                
                 // Other forms
                 ByteArray d2 = FromHexString(hex);
                 ByteArray d3;
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/LargeByteArray.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7LargeByteArrayTests : public UnitTest
+    {
+    public:
+        cc7LargeByteArrayTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testSmallArray)
+            CC7_REGISTER_TEST_METHOD(testGrowth)
+            CC7_REGISTER_TEST_METHOD(testResize)
+            CC7_REGISTER_TEST_METHOD(testMoveAndClear)
+        }
+
+        // Unit tests
+
+        void testSmallArray()
+        {
+            LargeByteArray array;
+            ccstAssertTrue(array.empty());
+            ccstAssertFalse(array.isMapped());
+
+            ByteArray chunk = getTestRandomData(1000);
+            array.append(chunk).append(0xAA);
+            ccstAssertEqual(array.size(), 1001);
+            ccstAssertFalse(array.isMapped());
+            ccstAssertEqual(array.byteRange().subRange(0, 1000), chunk);
+            ccstAssertEqual(array[1000], 0xAA);
+
+            array.resize(LargeByteArray::MAPPING_THRESHOLD);
+            ccstAssertFalse(array.isMapped());
+            ccstAssertEqual(array[LargeByteArray::MAPPING_THRESHOLD - 1], 0);
+        }
+
+        void testGrowth()
+        {
+            LargeByteArray array;
+            ByteArray chunk = getTestRandomData(64 * 1024 + 7);
+            const size_t chunks_count = 3 * LargeByteArray::MAPPING_THRESHOLD / chunk.size();
+            for (size_t i = 0; i < chunks_count; i++) {
+                chunk[0] = static_cast<cc7::byte>(i);
+                array.append(chunk);
+            }
+            ccstAssertTrue(array.isMapped());
+            ccstAssertEqual(array.size(), chunks_count * chunk.size());
+            ccstAssertTrue(array.capacity() >= array.size());
+
+            bool equal = true;
+            for (size_t i = 0; i < chunks_count && equal; i++) {
+                chunk[0] = static_cast<cc7::byte>(i);
+                equal = array.byteRange().subRange(i * chunk.size(), chunk.size()) == chunk;
+            }
+            ccstAssertTrue(equal);
+
+            // Appending own data
+            const size_t size = array.size();
+            array.reserve(size);
+            array.append(array.byteRange());
+            ccstAssertEqual(array.size(), size * 2);
+            ccstAssertEqual(array.byteRange().subRange(0, size), array.byteRange().subRange(size, size));
+            ccstAssertEqual(array.copyToByteArray(), array.byteRange());
+        }
+
+        void testResize()
+        {
+            LargeByteArray array;
+            const size_t size = 2 * LargeByteArray::MAPPING_THRESHOLD;
+            array.resize(size);
+            ccstAssertTrue(array.isMapped());
+            ccstAssertEqual(array.size(), size);
+            ccstAssertEqual(array[size - 1], 0);
+
+            memset(array.data(), 0xCC, size);
+            array.resize(10);
+            array.resize(size + 100);
+            ccstAssertEqual(array[9], 0xCC);
+            bool zeros = true;
+            for (size_t i = 10; i < array.size() && zeros; i++) {
+                zeros = array[i] == 0;
+            }
+            ccstAssertTrue(zeros);
+
+            array.clear();
+            ccstAssertTrue(array.empty());
+            ccstAssertTrue(array.isMapped());
+            array.append(ByteRange("abc"));
+            ccstAssertEqual(array.byteRange(), ByteRange("abc"));
+        }
+
+        void testMoveAndClear()
+        {
+            LargeByteArray array;
+            array.resize(LargeByteArray::MAPPING_THRESHOLD + 1);
+            array[0] = 0x55;
+            const cc7::byte * ptr = array.data();
+
+            LargeByteArray moved(std::move(array));
+            ccstAssertTrue(array.empty());
+            ccstAssertFalse(array.isMapped());
+            ccstAssertEqual(moved.data(), ptr);
+            ccstAssertEqual(moved[0], 0x55);
+
+            LargeByteArray other;
+            other.append(ByteRange("small"));
+            other = std::move(moved);
+            ccstAssertTrue(other.isMapped());
+            ccstAssertEqual(other.size(), LargeByteArray::MAPPING_THRESHOLD + 1);
+
+            other.secureClear();
+            ccstAssertTrue(other.empty());
+            ccstAssertFalse(other.isMapped());
+            ccstAssertEqual(other.capacity(), 0);
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7LargeByteArrayTests, "cc7")
+
+} // cc7::tests
+} // cc7
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/MappedFile.h>
+#include <stdio.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7MappedFileTests : public UnitTest
+    {
+    public:
+        cc7MappedFileTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testOpenFailure)
+#if !defined(CC7_WINDOWS)
+            CC7_REGISTER_TEST_METHOD(testReadOnly)
+            CC7_REGISTER_TEST_METHOD(testCopyOnWrite)
+            CC7_REGISTER_TEST_METHOD(testEmptyFile)
+#endif
+        }
+
+        // Helpers
+
+        FILE * createTempFile(const ByteRange & content)
+        {
+            FILE * f = tmpfile();
+            if (f && !content.empty()) {
+                fwrite(content.data(), 1, content.size(), f);
+                fflush(f);
+            }
+            return f;
+        }
+
+        // Unit tests
+
+        void testOpenFailure()
+        {
+            MappedFile file;
+            ccstAssertFalse(file.isOpen());
+            ccstAssertFalse(file.open("/this/file/should/not/exist.bin"));
+            ccstAssertFalse(file.isOpen());
+            ccstAssertTrue(file.byteRange().empty());
+        }
+
+#if !defined(CC7_WINDOWS)
+        void testReadOnly()
+        {
+            ByteArray content = getTestRandomData(3 * 4096 + 123);
+            FILE * f = createTempFile(content);
+            ccstAssertNotNull(f);
+            if (!f) {
+                return;
+            }
+            MappedFile::Options options;
+            options.will_need  = true;
+            options.huge_pages = true;
+            MappedFile file;
+            ccstAssertTrue(file.openDescriptor(fileno(f), options));
+            fclose(f);
+
+            ccstAssertTrue(file.isOpen());
+            ccstAssertEqual(file.mode(), MappedFile::ReadOnly);
+            ccstAssertTrue(file.mutableData() == nullptr);
+            ccstAssertEqual(file.size(), content.size());
+            ccstAssertEqual(file.byteRange(), content);
+            ccstAssertTrue(file.advise(MappedFile::Random, 5000, 100));
+            ccstAssertFalse(file.advise(MappedFile::Random, content.size()));
+
+            MappedFile moved(std::move(file));
+            ccstAssertFalse(file.isOpen());
+            ccstAssertEqual(moved.byteRange(), content);
+            moved.close();
+            ccstAssertFalse(moved.isOpen());
+            ccstAssertTrue(moved.data() == nullptr);
+        }
+
+        void testCopyOnWrite()
+        {
+            ByteArray content = getTestRandomData(1000);
+            FILE * f = createTempFile(content);
+            ccstAssertNotNull(f);
+            if (!f) {
+                return;
+            }
+            MappedFile::Options options;
+            options.mode = MappedFile::CopyOnWrite;
+            MappedFile file1, file2;
+            ccstAssertTrue(file1.openDescriptor(fileno(f), options));
+            ccstAssertTrue(file2.openDescriptor(fileno(f)));
+            fclose(f);
+
+            cc7::byte * p = file1.mutableData();
+            ccstAssertNotNull(p);
+            for (size_t i = 0; i < file1.size(); i++) {
+                p[i] ^= 0x5A;
+            }
+            // Private mapping is modified, shared mapping is not.
+            ccstAssertNotEqual(file1.byteRange(), content);
+            ccstAssertEqual(file2.byteRange(), content);
+            ccstAssertEqual(file1.data()[0], content[0] ^ 0x5A);
+        }
+
+        void testEmptyFile()
+        {
+            FILE * f = createTempFile(ByteRange());
+            ccstAssertNotNull(f);
+            if (!f) {
+                return;
+            }
+            MappedFile file;
+            ccstAssertTrue(file.openDescriptor(fileno(f)));
+            fclose(f);
+            ccstAssertTrue(file.isOpen());
+            ccstAssertTrue(file.empty());
+        }
+#endif
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7MappedFileTests, "cc7")
+
+} // cc7::tests
+} // cc7
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/MutableByteRange.h>
+#include <algorithm>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7MutableByteRangeTests : public UnitTest
+    {
+    public:
+        cc7MutableByteRangeTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testBasics)
+            CC7_REGISTER_TEST_METHOD(testBitwise)
+            CC7_REGISTER_TEST_METHOD(testXorWithPattern)
+            CC7_REGISTER_TEST_METHOD(testReverseRotateFill)
+            CC7_REGISTER_TEST_METHOD(testOutOfRange)
+        }
+
+        // Unit tests
+
+        void testBasics()
+        {
+            ByteArray array = { 1, 2, 3, 4, 5 };
+            MutableByteRange range(array);
+            ccstAssertEqual(range.size(), 5);
+            ccstAssertEqual(range.data(), array.data());
+            range[0] = 0x10;
+            ccstAssertEqual(array[0], 0x10);
+            
+            MutableByteRange sub = range.subRange(1, 3);
+            ccstAssertEqual(sub.byteRange(), ByteRange(array.data() + 1, 3));
+            sub.fill(0xEE);
+            ccstAssertEqual(array, ByteArray({ 0x10, 0xEE, 0xEE, 0xEE, 5 }));
+            ccstAssertEqual(range.subRangeFrom(4).size(), 1);
+            ccstAssertEqual(range.subRangeTo(2).size(), 2);
+            range.removePrefix(1);
+            range.removeSuffix(1);
+            ccstAssertEqual(range.size(), 3);
+            
+            range.copyFrom(ByteRange("ab"));
+            ccstAssertEqual(array, ByteArray({ 0x10, 'a', 'b', 0xEE, 5 }));
+            
+            cc7::byte buffer[4] = { 0 };
+            MutableByteRange raw(buffer, sizeof(buffer));
+            raw.fill(0x55);
+            ccstAssertEqual(buffer[3], 0x55);
+            
+            MutableByteRange empty;
+            ccstAssertTrue(empty.empty());
+            empty.fill(0);
+            empty.reverse();
+            empty.xorWith(ByteRange());
+            ccstAssertTrue(MakeMutableRange(array).byteRange() == array.byteRange());
+            
+            MutableByteRange full(array);
+            MutableByteRange part;
+            ccstAssertTrue(full.trySubRange(1, 4, part));
+            ccstAssertEqual(part.data(), array.data() + 1);
+            ccstAssertFalse(full.trySubRange(2, 4, part));
+            ccstAssertFalse(full.trySubRangeFrom(6, part));
+            ccstAssertTrue(full.trySubRangeTo(5, part));
+            ccstAssertEqual(part.size(), 5);
+            ccstAssertFalse(full.tryRemovePrefix(6));
+            ccstAssertTrue(full.tryRemoveSuffix(5));
+            ccstAssertTrue(full.empty());
+        }
+        
+        void testBitwise()
+        {
+            ByteArray a = getTestRandomData(300);
+            ByteArray b = getTestRandomData(300);
+            bool equal = true;
+            for (size_t offset = 0; offset < 8; offset++) {
+                for (size_t length = 0; length + offset <= 150; length++) {
+                    ByteArray x(a), o(a), n(a);
+                    MutableByteRange(x).subRange(offset, length).xorWith(b.byteRange().subRangeFrom(offset));
+                    MutableByteRange(o).subRange(offset, length).orWith(b.byteRange().subRangeFrom(offset));
+                    MutableByteRange(n).subRange(offset, length).andWith(b.byteRange().subRangeFrom(offset));
+                    for (size_t i = 0; i < a.size(); i++) {
+                        const bool inside = i >= offset && i < offset + length;
+                        equal &= x[i] == (inside ? a[i] ^ b[i] : a[i]);
+                        equal &= o[i] == (inside ? a[i] | b[i] : a[i]);
+                        equal &= n[i] == (inside ? a[i] & b[i] : a[i]);
+                    }
+                }
+            }
+            ccstAssertTrue(equal);
+            
+            // XOR with itself
+            ByteArray c(a);
+            MutableByteRange(c).xorWith(c);
+            ccstAssertEqual(c, ByteArray(a.size(), 0));
+        }
+        
+        void testXorWithPattern()
+        {
+            ByteArray data = getTestRandomData(200);
+            bool equal = true;
+            for (size_t pattern_size = 1; pattern_size <= 40; pattern_size++) {
+                ByteArray pattern = getTestRandomData(pattern_size);
+                for (size_t length : { 0, 1, 31, 32, 33, 64, 100, 200 }) {
+                    ByteArray x(data);
+                    MutableByteRange(x).subRangeTo(length).xorWithPattern(pattern);
+                    for (size_t i = 0; i < x.size(); i++) {
+                        equal &= x[i] == (i < length ? data[i] ^ pattern[i % pattern_size] : data[i]);
+                    }
+                }
+            }
+            ccstAssertTrue(equal);
+            
+            // WebSocket masking, applied twice produces the original data
+            ByteArray payload(data);
+            const ByteArray mask = { 0x37, 0xFA, 0x21, 0x3D };
+            MutableByteRange(payload).xorWithPattern(mask);
+            ccstAssertNotEqual(payload, data);
+            MutableByteRange(payload).xorWithPattern(mask);
+            ccstAssertEqual(payload, data);
+        }
+        
+        void testReverseRotateFill()
+        {
+            ByteArray data = getTestRandomData(100);
+            bool equal = true;
+            for (size_t length = 0; length <= data.size(); length++) {
+                ByteArray x(data.byteRange().subRangeTo(length));
+                ByteArray expected(x);
+                std::reverse(expected.begin(), expected.end());
+                MutableByteRange(x).reverse();
+                equal &= x == expected;
+                
+                for (size_t count = 0; count <= length; count += 1 + length / 7) {
+                    ByteArray y(data.byteRange().subRangeTo(length));
+                    ByteArray expected_rotation(y);
+                    std::rotate(expected_rotation.begin(), expected_rotation.begin() + count, expected_rotation.end());
+                    MutableByteRange(y).rotate(count);
+                    equal &= y == expected_rotation;
+                }
+            }
+            ccstAssertTrue(equal);
+            
+            ByteArray z(33, 1);
+            MutableByteRange(z).subRange(1, 31).fill(0xCC);
+            ccstAssertEqual(z.front(), 1);
+            ccstAssertEqual(z.back(), 1);
+            ccstAssertEqual(std::count(z.begin(), z.end(), 0xCC), 31);
+        }
+        
+        void testOutOfRange()
+        {
+#if !defined(CC7_NO_EXCEPTIONS)
+            ByteArray data(10, 0);
+            MutableByteRange range(data);
+            ByteArray short_data(9, 0);
+            size_t exceptions = 0;
+            try { range.xorWith(short_data); } catch (std::out_of_range &) { exceptions++; }
+            try { range.andWith(short_data); } catch (std::out_of_range &) { exceptions++; }
+            try { range.orWith(short_data); } catch (std::out_of_range &) { exceptions++; }
+            try { range.rotate(11); } catch (std::out_of_range &) { exceptions++; }
+            try { range.subRange(5, 6); } catch (std::out_of_range &) { exceptions++; }
+            try { range.copyFrom(ByteArray(11, 0)); } catch (std::out_of_range &) { exceptions++; }
+            try { range.xorWithPattern(ByteRange()); } catch (std::invalid_argument &) { exceptions++; }
+            ccstAssertEqual(exceptions, 7);
+            ccstAssertEqual(data, ByteArray(10, 0));
+#endif
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7MutableByteRangeTests, "cc7")
+
+} // cc7::tests
+} // cc7
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/OwnedBytes.h>
+#include <stdlib.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7OwnedBytesTests : public UnitTest
+    {
+    public:
+        cc7OwnedBytesTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testAdopt)
+            CC7_REGISTER_TEST_METHOD(testWipePolicy)
+            CC7_REGISTER_TEST_METHOD(testRelease)
+        }
+
+        struct DeleterState
+        {
+            ByteArray   observed;
+            int         calls;
+        };
+
+        static void testDeleter(cc7::byte * p, size_t size, void * context)
+        {
+            DeleterState * state = static_cast<DeleterState*>(context);
+            state->observed.assign(p, p + size);
+            state->calls++;
+        }
+
+        // Unit tests
+
+        void testAdopt()
+        {
+            OwnedBytes empty;
+            ccstAssertTrue(empty.empty());
+            ccstAssertTrue(empty.data() == nullptr);
+
+            ByteArray data = getTestRandomData(100);
+            void * ptr = malloc(data.size());
+            memcpy(ptr, data.data(), data.size());
+
+            OwnedBytes b1 = OwnedBytes::adoptMalloc(ptr, data.size());
+            ccstAssertEqual(b1.data(), ptr);
+            ccstAssertEqual(b1.byteRange(), data);
+
+            // Move
+            ccstAssertTrue(std::is_nothrow_move_constructible<OwnedBytes>::value);
+            ccstAssertTrue(std::is_nothrow_move_assignable<OwnedBytes>::value);
+            OwnedBytes b2(std::move(b1));
+            ccstAssertTrue(b1.empty());
+            ccstAssertEqual(b2.data(), ptr);
+            b1 = std::move(b2);
+            ccstAssertEqual(b1.data(), ptr);
+            ccstAssertEqual(b1.copyToByteArray(), data);
+
+            OwnedBytes b3 = OwnedBytes::copyFrom(data);
+            ccstAssertEqual(b3, b1);
+            ccstAssertNotEqual(b3.data(), b1.data());
+
+            b3[0] ^= 0xFF;
+            ccstAssertNotEqual(b3, b1);
+
+            OwnedBytes b4 = OwnedBytes::adopt(nullptr, 10, nullptr);
+            ccstAssertTrue(b4.empty());
+        }
+
+        void testWipePolicy()
+        {
+            cc7::byte buffer[32];
+            DeleterState state;
+            state.calls = 0;
+
+            memset(buffer, 0xAA, sizeof(buffer));
+            {
+                OwnedBytes b = OwnedBytes::adopt(buffer, sizeof(buffer), testDeleter, &state);
+                ccstAssertEqual(b.wipePolicy(), OwnedBytes::Wipe);
+            }
+            ccstAssertEqual(state.calls, 1);
+            ccstAssertEqual(state.observed, ByteArray(sizeof(buffer), 0));
+
+            memset(buffer, 0xAA, sizeof(buffer));
+            {
+                OwnedBytes b = OwnedBytes::adopt(buffer, sizeof(buffer), testDeleter, &state, OwnedBytes::NoWipe);
+                b.reset();
+                ccstAssertTrue(b.empty());
+            }
+            ccstAssertEqual(state.calls, 2);
+            ccstAssertEqual(state.observed, ByteArray(sizeof(buffer), 0xAA));
+        }
+
+        void testRelease()
+        {
+            OwnedBytes b = OwnedBytes::copyFrom(ByteRange("Hello world"));
+            const cc7::byte * ptr = b.data();
+
+            OwnedBytes::Deleter deleter = nullptr;
+            void * context = &deleter;
+            cc7::byte * released = b.release(&deleter, &context);
+            ccstAssertEqual(released, ptr);
+            ccstAssertTrue(b.empty());
+            ccstAssertTrue(b.release() == nullptr);
+            ccstAssertTrue(deleter != nullptr);
+            ccstAssertTrue(context == nullptr);
+            ccstAssertEqual(CopyToString(ByteRange(released, 11)), "Hello world");
+            // Memory allocated by OwnedBytes can be released with free()
+            free(released);
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7OwnedBytesTests, "cc7")
+
+} // cc7::tests
+} // cc7
@@ -32,6 +32,7 @@ namespace tests
             CC7_REGISTER_TEST_METHOD(testEndian32)
             CC7_REGISTER_TEST_METHOD(testEndian64)
             CC7_REGISTER_TEST_METHOD(testEndianIntrinsics)
+            CC7_REGISTER_TEST_METHOD(testSecureClean)
         }
         
         void testPlatformBits()
@@ -135,6 +136,31 @@ namespace tests
             ccstAssertEqual(u64src, u64dst);
         }
         
+        void testSecureClean()
+        {
+            const size_t sizes[] = { 1, 7, 31, 255, 256, 257, 1000, 4096 + 3, 65536, 5 * 1024 * 1024 + 11 };
+            for (size_t size : sizes) {
+                for (size_t offset = 0; offset < 3; offset++) {
+                    // Buffer with guard bytes around the cleaned area
+                    ByteArray buffer(size + offset + 2, 0xA5);
+                    CC7_SecureClean(buffer.data() + offset + 1, size);
+                    ccstAssertEqual(buffer[offset], 0xA5);
+                    ccstAssertEqual(buffer[offset + size + 1], 0xA5);
+                    const byte * p = buffer.data() + offset + 1;
+                    bool all_zero = true;
+                    for (size_t i = 0; i < size; i++) {
+                        if (p[i] != 0) {
+                            all_zero = false;
+                            break;
+                        }
+                    }
+                    ccstAssertTrue(all_zero, "Size %zu, offset %zu", size, offset);
+                }
+            }
+            // Must not crash
+            CC7_SecureClean(nullptr, 0);
+        }
+        
     };
     
     CC7_CREATE_UNIT_TEST(cc7PlatformTests, "cc7")
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/RecyclingPool.h>
+#include <thread>
+
+namespace cc7
+{
+namespace tests
+{
+    /**
+     The LateAllocation is a thread-local object, which is constructed before
+     the pool's thread cache, so it's destroyed after the cache.
+     */
+    struct LateAllocation
+    {
+        void ** out_block;
+        
+        ~LateAllocation()
+        {
+            *out_block = RecyclingPool::allocate(20);
+            memset(*out_block, 0xAA, 20);
+        }
+    };
+    
+    class cc7RecyclingPoolTests : public UnitTest
+    {
+    public:
+        cc7RecyclingPoolTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testRecycling)
+            CC7_REGISTER_TEST_METHOD(testByteArray)
+            CC7_REGISTER_TEST_METHOD(testDepot)
+            CC7_REGISTER_TEST_METHOD(testThreads)
+            CC7_REGISTER_TEST_METHOD(testAllocationAfterThreadCache)
+        }
+
+        // Unit tests
+
+        void testRecycling()
+        {
+            RecyclingPool::flushThreadCache();
+            RecyclingPool::purgeDepot();
+            RecyclingPool::Statistics s0 = RecyclingPool::statistics();
+
+            // First allocation is a miss, then the block is recycled.
+            void * p1 = RecyclingPool::allocate(20);
+            ccstAssertNotNull(p1);
+            memset(p1, 0xCC, 20);
+            RecyclingPool::deallocate(p1, 20);
+            // Released block is wiped, except the free list link.
+            const cc7::byte * b = static_cast<const cc7::byte*>(p1);
+            bool wiped = true;
+            for (size_t i = sizeof(void*); i < 20; i++) {
+                wiped &= b[i] == 0;
+            }
+            ccstAssertTrue(wiped);
+
+            void * p2 = RecyclingPool::allocate(32);
+            ccstAssertEqual(p2, p1);
+            RecyclingPool::deallocate(p2, 32);
+
+            void * large = RecyclingPool::allocate(1000);
+            ccstAssertNotNull(large);
+            RecyclingPool::deallocate(large, 1000);
+
+            RecyclingPool::Statistics s1 = RecyclingPool::statistics();
+            ccstAssertEqual(s1.misses - s0.misses, 1);
+            ccstAssertEqual(s1.hits - s0.hits, 1);
+            ccstAssertEqual(s1.large_allocations - s0.large_allocations, 1);
+        }
+
+        void testByteArray()
+        {
+            ByteArray data = getTestRandomData(100);
+            RecycledByteArray a1(data.byteRange());
+            ccstAssertEqual(a1.byteRange(), data);
+            a1.append(data.byteRange().subRange(0, 50));
+            ccstAssertEqual(a1.size(), 150);
+            RecycledByteArray a2 = a1;
+            ccstAssertEqual(a2.byteRange(), a1.byteRange());
+            a1.secureClear();
+            ccstAssertTrue(a1.empty());
+        }
+
+        void testDepot()
+        {
+            RecyclingPool::flushThreadCache();
+            RecyclingPool::purgeDepot();
+            RecyclingPool::Statistics s0 = RecyclingPool::statistics();
+            ccstAssertEqual(s0.depot_blocks, 0);
+
+            // Overflow of thread cache moves blocks to depot
+            const size_t count = RecyclingPool::THREAD_CACHE_LIMIT + 10;
+            std::vector<void*> blocks;
+            for (size_t i = 0; i < count; i++) {
+                blocks.push_back(RecyclingPool::allocate(64));
+            }
+            for (auto p : blocks) {
+                RecyclingPool::deallocate(p, 64);
+            }
+            RecyclingPool::Statistics s1 = RecyclingPool::statistics();
+            ccstAssertEqual(s1.depot_returns - s0.depot_returns, 1);
+            ccstAssertEqual(s1.depot_blocks, RecyclingPool::THREAD_CACHE_LIMIT / 2);
+
+            RecyclingPool::flushThreadCache();
+            RecyclingPool::Statistics s2 = RecyclingPool::statistics();
+            ccstAssertEqual(s2.depot_blocks, count);
+
+            // Refill from depot
+            void * p = RecyclingPool::allocate(64);
+            RecyclingPool::Statistics s3 = RecyclingPool::statistics();
+            ccstAssertEqual(s3.depot_refills - s2.depot_refills, 1);
+            ccstAssertEqual(s3.misses, s2.misses);
+            RecyclingPool::deallocate(p, 64);
+
+            RecyclingPool::flushThreadCache();
+            RecyclingPool::purgeDepot();
+            ccstAssertEqual(RecyclingPool::statistics().depot_blocks, 0);
+        }
+
+        void testThreads()
+        {
+            RecyclingPool::Statistics s0 = RecyclingPool::statistics();
+            const size_t threads_count = 4;
+            bool results[threads_count];
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < threads_count; t++) {
+                results[t] = false;
+                threads.push_back(std::thread([&results, t]() {
+                    for (size_t i = 0; i < 2000; i++) {
+                        RecycledByteArray a(16 + (i % 200), cc7::byte(t));
+                        RecycledByteArray b(a);
+                        if (a.byteRange() != b.byteRange() || a[0] != t) {
+                            return;
+                        }
+                    }
+                    results[t] = true;
+                }));
+            }
+            for (auto && t : threads) {
+                t.join();
+            }
+            for (size_t t = 0; t < threads_count; t++) {
+                ccstAssertTrue(results[t]);
+            }
+            RecyclingPool::Statistics s1 = RecyclingPool::statistics();
+            // Most allocations are served from the thread's cache
+            ccstAssertTrue(s1.hits - s0.hits > s1.misses - s0.misses);
+            // Finished threads returned their blocks to the depot
+            ccstAssertTrue(s1.depot_blocks > 0);
+            RecyclingPool::purgeDepot();
+        }
+        
+        void testAllocationAfterThreadCache()
+        {
+            // Allocate a block after the thread's cache is destroyed.
+            void * block = nullptr;
+            std::thread thread([&block]() {
+                static thread_local LateAllocation late;
+                late.out_block = &block;
+                // Creates the thread cache, after the LateAllocation object.
+                RecyclingPool::deallocate(RecyclingPool::allocate(20), 20);
+            });
+            thread.join();
+            ccstAssertNotNull(block);
+            
+            // Release the block to this thread's free list, then reuse it with
+            // the whole size of its class.
+            RecyclingPool::flushThreadCache();
+            RecyclingPool::purgeDepot();
+            RecyclingPool::deallocate(block, 20);
+            cc7::byte * reused = static_cast<cc7::byte*>(RecyclingPool::allocate(32));
+            ccstAssertEqual((void*)reused, block);
+            memset(reused, 0x55, 32);
+            RecyclingPool::deallocate(reused, 32);
+            RecyclingPool::flushThreadCache();
+            RecyclingPool::purgeDepot();
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7RecyclingPoolTests, "cc7")
+
+} // cc7::tests
+} // cc7
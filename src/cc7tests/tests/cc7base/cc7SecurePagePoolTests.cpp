@@ -0,0 +1,134 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/SecurePagePool.h>
+#include <cc7/HexString.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7SecurePagePoolTests : public UnitTest
+    {
+    public:
+        cc7SecurePagePoolTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testSizeClasses)
+            CC7_REGISTER_TEST_METHOD(testRecycling)
+            CC7_REGISTER_TEST_METHOD(testLargeBlocks)
+            CC7_REGISTER_TEST_METHOD(testLockedByteArray)
+        }
+
+        // Unit tests
+
+        void testSizeClasses()
+        {
+            SecurePagePool pool;
+            std::vector<std::pair<byte*, size_t>> blocks;
+            for (size_t size = 1; size <= SecurePagePool::MAX_SLOT_SIZE; size = size * 2 + 1) {
+                byte * p = reinterpret_cast<byte*>(pool.allocate(size));
+                ccstAssertNotNull(p);
+                memset(p, 0xA5, size);
+                blocks.push_back(std::make_pair(p, size));
+            }
+            auto stats = pool.statistics();
+            ccstAssertEqual(stats.allocations, blocks.size());
+            ccstAssertEqual(stats.used_slots, blocks.size());
+            ccstAssertEqual(stats.large_allocations, 0);
+            ccstAssertTrue(stats.regions > 0);
+            ccstAssertEqual(stats.locked_bytes + stats.lock_failures * pool.config().region_size, stats.regions * pool.config().region_size);
+            if (stats.lock_failures > 0) {
+                ccstMessage("WARNING: SecurePagePool could not lock memory on this system.");
+            }
+            for (auto && block : blocks) {
+                pool.deallocate(block.first, block.second);
+            }
+            stats = pool.statistics();
+            ccstAssertEqual(stats.deallocations, blocks.size());
+            ccstAssertEqual(stats.used_slots, 0);
+            ccstAssertEqual(stats.used_bytes, 0);
+        }
+
+        void testRecycling()
+        {
+            SecurePagePool pool;
+            byte * p1 = reinterpret_cast<byte*>(pool.allocate(32));
+            memset(p1, 0xCC, 32);
+            pool.deallocate(p1, 32);
+            size_t regions = pool.statistics().regions;
+
+            // The same slot is reused and its content is wiped.
+            byte * p2 = reinterpret_cast<byte*>(pool.allocate(30));
+            ccstAssertEqual(p1, p2);
+            ccstAssertEqual(ByteRange(p2 + sizeof(void*), 32 - sizeof(void*)), ByteArray(32 - sizeof(void*), 0));
+            pool.deallocate(p2, 30);
+
+            // Exhaust the whole region, to force a new one.
+            const size_t count = pool.config().region_size / 32 + 1;
+            std::vector<void*> ptrs;
+            for (size_t i = 0; i < count; i++) {
+                ptrs.push_back(pool.allocate(32));
+            }
+            ccstAssertEqual(pool.statistics().regions, regions + 1);
+            for (void * p : ptrs) {
+                pool.deallocate(p, 32);
+            }
+            ccstAssertEqual(pool.statistics().used_slots, 0);
+        }
+
+        void testLargeBlocks()
+        {
+            SecurePagePool pool;
+            const size_t size = SecurePagePool::MAX_SLOT_SIZE * 3 + 7;
+            byte * p = reinterpret_cast<byte*>(pool.allocate(size));
+            ccstAssertNotNull(p);
+            memset(p, 0x11, size);
+            auto stats = pool.statistics();
+            ccstAssertEqual(stats.large_allocations, 1);
+            ccstAssertEqual(stats.used_bytes, size);
+            ccstAssertEqual(stats.regions, 0);
+            pool.deallocate(p, size);
+            stats = pool.statistics();
+            ccstAssertEqual(stats.used_bytes, 0);
+            ccstAssertEqual(stats.mapped_bytes, 0);
+            ccstAssertEqual(stats.locked_bytes, 0);
+        }
+
+        void testLockedByteArray()
+        {
+            ByteArray data = getTestRandomData(100);
+            LockedByteArray locked(data);
+            ccstAssertEqual(locked.byteRange(), data);
+            locked.append(data);
+            locked.append({1, 2, 3});
+            ccstAssertEqual(locked.size(), 203);
+            ccstAssertEqual(locked.byteRange().subRangeTo(100), data);
+            ccstAssertEqual(locked.byteRange().subRangeFrom(200), ByteArray({1, 2, 3}));
+            ccstAssertEqual(ToHexString(locked.byteRange().subRangeTo(4)), data.byteRange().subRangeTo(4).hexString());
+
+            LockedByteArray large(10000, 0xEE);
+            ccstAssertEqual(large.size(), 10000);
+            large.secureClear();
+            ccstAssertTrue(large.empty());
+        }
+
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7SecurePagePoolTests, "cc7")
+
+} // cc7::tests
+} // cc7
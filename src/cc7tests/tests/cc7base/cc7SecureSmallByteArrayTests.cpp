@@ -0,0 +1,211 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/SecureSmallByteArray.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7SecureSmallByteArrayTests : public UnitTest
+    {
+    public:
+        cc7SecureSmallByteArrayTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testCreation)
+            CC7_REGISTER_TEST_METHOD(testAppendAndSpill)
+            CC7_REGISTER_TEST_METHOD(testCopyAndMove)
+            CC7_REGISTER_TEST_METHOD(testAssign)
+            CC7_REGISTER_TEST_METHOD(testCodecs)
+        }
+
+        typedef SecureSmallByteArray<16> SmallArray;
+
+        // Unit tests
+
+        void testCreation()
+        {
+            SmallArray a1;
+            ccstAssertTrue(a1.empty());
+            ccstAssertTrue(a1.isInline());
+            ccstAssertEqual(a1.capacity(), 16);
+
+            SmallArray a2({1, 2, 3});
+            ccstAssertEqual(a2.size(), 3);
+            ccstAssertTrue(a2.isInline());
+            ccstAssertEqual(a2.byteRange(), ByteArray({1, 2, 3}));
+
+            SmallArray a3(4, 0xCC);
+            ccstAssertEqual(a3.byteRange(), ByteArray(4, 0xCC));
+
+            ByteArray ba = getTestRandomData(40);
+            SmallArray a4(ba);
+            ccstAssertFalse(a4.isInline());
+            ccstAssertEqual(a4.size(), 40);
+            ccstAssertEqual(a4.byteRange(), ba);
+
+            SmallArray a5(ba.byteRange().subRangeTo(16));
+            ccstAssertTrue(a5.isInline());
+            ccstAssertEqual(a5, ba.byteRange().subRangeTo(16));
+
+            ccstAssertEqual(a2.at(2), 3);
+#if !defined(CC7_NO_EXCEPTIONS)
+            bool exception = false;
+            try {
+                a2.at(3);
+            } catch (std::out_of_range &) {
+                exception = true;
+            }
+            ccstAssertTrue(exception);
+#endif
+        }
+
+        void testAppendAndSpill()
+        {
+            TestByteVector bv;
+            SmallArray sa;
+            for (size_t i = 0; i < 16; i++) {
+                TestByteVector rdata = getTestRandomDataVector((random() & 0x7) + 1);
+                bv.insert(bv.end(), rdata.begin(), rdata.end());
+                sa.append(ByteRange(rdata.data(), rdata.size()));
+                ccstAssertTrue(sa.isInline() == (bv.size() <= 16));
+            }
+            ccstAssertEqual(bv.size(), sa.size());
+            ccstAssertTrue(memcmp(bv.data(), sa.data(), bv.size()) == 0);
+
+            // Append own content
+            SmallArray self({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+            self.append(self.byteRange());
+            ccstAssertFalse(self.isInline());
+            ccstAssertEqual(self, ByteArray({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+
+            // Resize
+            SmallArray r;
+            r.resize(8, 0xAA);
+            ccstAssertEqual(r, ByteArray(8, 0xAA));
+            r.resize(4);
+            ccstAssertEqual(r, ByteArray(4, 0xAA));
+            r.push_back(0xBB);
+            ccstAssertEqual(r.size(), 5);
+            ccstAssertEqual(r[4], 0xBB);
+
+            r.reserve(100);
+            ccstAssertFalse(r.isInline());
+            ccstAssertTrue(r.capacity() >= 100);
+            ccstAssertEqual(r.size(), 5);
+
+            r.secureClear();
+            ccstAssertTrue(r.empty());
+        }
+
+        void testCopyAndMove()
+        {
+            ByteArray small_data = getTestRandomData(12);
+            ByteArray large_data = getTestRandomData(48);
+
+            // Inline copy & move
+            SmallArray a1(small_data);
+            SmallArray a2(a1);
+            ccstAssertEqual(a1, a2);
+            ccstAssertNotEqual(a1.data(), a2.data());
+            SmallArray a3(std::move(a1));
+            ccstAssertEqual(a3, small_data);
+            ccstAssertTrue(a1.empty());
+            ccstAssertTrue(a1.isInline());
+            // Moved-from inline storage must be wiped
+            ccstAssertEqual(ByteRange(a1.data(), small_data.size()), ByteArray(small_data.size(), 0));
+
+            // Heap copy & move
+            SmallArray b1(large_data);
+            const cc7::byte * b1_ptr = b1.data();
+            SmallArray b2(b1);
+            ccstAssertEqual(b1, b2);
+            SmallArray b3(std::move(b1));
+            ccstAssertEqual(b3, large_data);
+            ccstAssertEqual(b3.data(), b1_ptr);
+            ccstAssertTrue(b1.empty());
+            ccstAssertTrue(b1.isInline());
+
+            // Move assignment
+            b2 = std::move(a3);
+            ccstAssertEqual(b2, small_data);
+            ccstAssertTrue(b2.isInline());
+            a2 = std::move(b3);
+            ccstAssertEqual(a2, large_data);
+            ccstAssertFalse(a2.isInline());
+        }
+
+        void testAssign()
+        {
+            SmallArray a1({1, 2, 3, 4, 5, 6});
+            a1.assign(a1.byteRange().subRangeFrom(2));
+            ccstAssertEqual(a1, ByteArray({3, 4, 5, 6}));
+
+            ByteArray large = getTestRandomData(33);
+            a1 = large;
+            ccstAssertEqual(a1, large);
+            a1 = ByteArray({7, 8});
+            ccstAssertEqual(a1, ByteArray({7, 8}));
+
+            SmallArray a2;
+            a2 = a1;
+            ccstAssertEqual(a2, a1);
+        }
+
+        void testCodecs()
+        {
+            SmallArray a1({0xDE, 0xAD, 0xBE, 0xEF});
+            ccstAssertEqual(a1.hexString(), "DEADBEEF");
+            ccstAssertEqual(a1.base64String(), "3q2+7w==");
+            ccstAssertEqual(ToHexString(a1), "DEADBEEF");
+
+            SmallArray a2;
+            ccstAssertTrue(a2.readFromHexString("CAFEBABE"));
+            ccstAssertEqual(a2, ByteArray({0xCA, 0xFE, 0xBA, 0xBE}));
+            ccstAssertTrue(a2.readFromBase64String("3q2+7w=="));
+            ccstAssertEqual(a2, a1);
+            ccstAssertFalse(a2.readFromHexString("XYZ"));
+            ccstAssertTrue(a2.empty());
+
+            // Decoded directly to the inline storage
+            ByteArray data = getTestRandomData(40);
+            SmallArray a3;
+            ccstAssertTrue(a3.readFromBase64String(ToBase64String(data.byteRange().subRangeTo(16))));
+            ccstAssertTrue(a3.isInline());
+            ccstAssertEqual(a3, data.byteRange().subRangeTo(16));
+            ccstAssertTrue(a3.readFromHexString(ToHexString(data.byteRange().subRangeTo(15))));
+            ccstAssertTrue(a3.isInline());
+            ccstAssertEqual(a3, data.byteRange().subRangeTo(15));
+            ccstAssertFalse(a3.readFromBase64String("3q2+7w=?"));
+            ccstAssertTrue(a3.empty());
+            ccstAssertTrue(a3.isInline());
+            // Spill to the heap
+            ccstAssertTrue(a3.readFromBase64String(ToBase64String(data, 64), 64));
+            ccstAssertFalse(a3.isInline());
+            ccstAssertEqual(a3, data);
+            ccstAssertTrue(a3.readFromHexString(ToHexString(data)));
+            ccstAssertEqual(a3, data);
+            ccstAssertFalse(a3.readFromBase64String(std::string(100, '?')));
+            ccstAssertTrue(a3.empty());
+        }
+
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7SecureSmallByteArrayTests, "cc7")
+
+} // cc7::tests
+} // cc7
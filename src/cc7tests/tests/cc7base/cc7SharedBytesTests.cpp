@@ -0,0 +1,140 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/SharedBytes.h>
+#include <thread>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7SharedBytesTests : public UnitTest
+    {
+    public:
+        cc7SharedBytesTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testCreation)
+            CC7_REGISTER_TEST_METHOD(testSlicing)
+            CC7_REGISTER_TEST_METHOD(testThreads)
+        }
+
+        // Unit tests
+
+        void testCreation()
+        {
+            SharedBytes s1;
+            ccstAssertTrue(s1.empty());
+            ccstAssertEqual(s1.useCount(), 0);
+
+            ByteArray data = getTestRandomData(64);
+            ByteArray data_copy = data;
+            const cc7::byte * data_ptr = data.data();
+            SharedBytes s2(std::move(data));
+            ccstAssertEqual(s2.data(), data_ptr);
+            ccstAssertEqual(s2.byteRange(), data_copy);
+            ccstAssertEqual(s2.useCount(), 1);
+
+            SharedBytes s3 = s2;
+            ccstAssertEqual(s2.useCount(), 2);
+            ccstAssertEqual(s3.data(), s2.data());
+            ccstAssertEqual(s3, s2);
+
+            SharedBytes s4(std::move(s3));
+            ccstAssertEqual(s2.useCount(), 2);
+            ccstAssertTrue(s3.empty());
+
+            s4.reset();
+            ccstAssertEqual(s2.useCount(), 1);
+            ccstAssertTrue(s4.empty());
+
+            SharedBytes s5(ByteRange("Hello world"));
+            ccstAssertEqual(CopyToString(s5.byteRange()), "Hello world");
+            ccstAssertEqual(s5.copyToByteArray(), ByteArray(ByteRange("Hello world")));
+        }
+
+        void testSlicing()
+        {
+            ByteArray data = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+            SharedBytes s1(std::move(data));
+
+            SharedBytes s2 = s1.subBytes(2, 4);
+            ccstAssertEqual(s2.byteRange(), ByteArray({3, 4, 5, 6}));
+            ccstAssertEqual(s1.useCount(), 2);
+
+            SharedBytes s3 = s2.subBytesFrom(1);
+            ccstAssertEqual(s3.byteRange(), ByteArray({4, 5, 6}));
+            SharedBytes s4 = s3.subBytesTo(2);
+            ccstAssertEqual(s4.byteRange(), ByteArray({4, 5}));
+            ccstAssertEqual(s1.useCount(), 4);
+
+            // Slices keep the buffer alive
+            s1.reset();
+            s2.reset();
+            s3.reset();
+            ccstAssertEqual(s4.useCount(), 1);
+            ccstAssertEqual(s4[1], 5);
+
+            ccstAssertTrue(s4.subBytes(2, 0).empty());
+#if !defined(CC7_NO_EXCEPTIONS)
+            bool exception = false;
+            try {
+                s4.subBytes(1, 2);
+            } catch (std::out_of_range &) {
+                exception = true;
+            }
+            ccstAssertTrue(exception);
+#endif
+        }
+
+        void testThreads()
+        {
+            ByteArray data = getTestRandomData(1024);
+            ByteArray reference = data;
+            SharedBytes shared(std::move(data));
+
+            const size_t threads_count = 4;
+            bool results[threads_count];
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < threads_count; i++) {
+                SharedBytes slice = shared.subBytes(i * 256, 256);
+                results[i] = false;
+                threads.push_back(std::thread([slice, &reference, &results, i]() {
+                    // Each thread creates and destroys more copies
+                    for (int n = 0; n < 1000; n++) {
+                        SharedBytes copy = slice;
+                        if (copy.byteRange() != reference.byteRange().subRange(i * 256, 256)) {
+                            return;
+                        }
+                    }
+                    results[i] = true;
+                }));
+            }
+            for (auto && t : threads) {
+                t.join();
+            }
+            for (size_t i = 0; i < threads_count; i++) {
+                ccstAssertTrue(results[i]);
+            }
+            ccstAssertEqual(shared.useCount(), 1);
+        }
+
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7SharedBytesTests, "cc7")
+
+} // cc7::tests
+} // cc7
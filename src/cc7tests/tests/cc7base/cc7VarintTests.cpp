@@ -0,0 +1,206 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/Varint.h>
+#include <cc7/HexString.h>
+#include <cc7/ByteWriter.h>
+#include <cc7/ByteReader.h>
+
+namespace cc7
+{
+namespace tests
+{
+    class cc7VarintTests : public UnitTest
+    {
+    public:
+        cc7VarintTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testSingleValues)
+            CC7_REGISTER_TEST_METHOD(testMalformed)
+            CC7_REGISTER_TEST_METHOD(testArrays)
+            CC7_REGISTER_TEST_METHOD(testReaderWriter)
+        }
+
+        // Unit tests
+
+        void testSingleValues()
+        {
+            struct TestData {
+                U64 value;
+                const char * encoded;
+            };
+            static const TestData vectors[] = {
+                { 0,                        "00" },
+                { 1,                        "01" },
+                { 127,                      "7F" },
+                { 128,                      "8001" },
+                { 300,                      "AC02" },
+                { 16383,                    "FF7F" },
+                { 16384,                    "808001" },
+                { 0xFFFFFFFF,               "FFFFFFFF0F" },
+                { 0x100000000ULL,           "8080808010" },
+                { 0xFFFFFFFFFFFFFFFFULL,    "FFFFFFFFFFFFFFFFFF01" },
+                { 0, nullptr }
+            };
+            for (const TestData * td = vectors; td->encoded; td++) {
+                ByteArray expected = FromHexString(td->encoded);
+                cc7::byte buffer[VARINT_MAX_SIZE_U64];
+                size_t size = Varint_Encode(td->value, buffer);
+                ccstAssertEqual(size, Varint_EncodedSize(td->value));
+                ccstAssertEqual(ByteRange(buffer, size), expected);
+
+                U64 value64;
+                ccstAssertTrue(Varint_Decode(expected, value64, size));
+                ccstAssertEqual(value64, td->value);
+                ccstAssertEqual(size, expected.size());
+
+                U32 value32;
+                bool result = Varint_Decode(expected, value32, size);
+                ccstAssertTrue(result == (td->value <= 0xFFFFFFFF));
+                if (result) {
+                    ccstAssertEqual(value32, td->value);
+                }
+            }
+
+            ccstAssertEqual(Varint_ZigZagEncode(0), 0);
+            ccstAssertEqual(Varint_ZigZagEncode(-1), 1);
+            ccstAssertEqual(Varint_ZigZagEncode(1), 2);
+            ccstAssertEqual(Varint_ZigZagEncode(-2), 3);
+            ccstAssertEqual(Varint_ZigZagDecode(Varint_ZigZagEncode(INT64_MIN)), INT64_MIN);
+            ccstAssertEqual(Varint_ZigZagDecode(Varint_ZigZagEncode(INT64_MAX)), INT64_MAX);
+        }
+
+        void testMalformed()
+        {
+            U32 value32;
+            U64 value64;
+            size_t size;
+            // Empty and incomplete
+            ccstAssertFalse(Varint_Decode(ByteRange(), value64, size));
+            ccstAssertFalse(Varint_Decode(FromHexString("80"), value64, size));
+            ccstAssertFalse(Varint_Decode(FromHexString("FFFF"), value32, size));
+            // Too long
+            ccstAssertFalse(Varint_Decode(FromHexString("FFFFFFFF1F"), value32, size));
+            ccstAssertFalse(Varint_Decode(FromHexString("FFFFFFFF8F01"), value32, size));
+            ccstAssertFalse(Varint_Decode(FromHexString("FFFFFFFFFFFFFFFFFF02"), value64, size));
+            ccstAssertFalse(Varint_Decode(FromHexString("8080808080808080808000"), value64, size));
+
+            // Array decoding stops at the malformed value
+            U32 values[16];
+            size_t consumed;
+            ByteArray data = FromHexString("0102AC0203FFFFFFFF1F0405060708090A");
+            ccstAssertEqual(Varint_DecodeArray(data, values, 16, consumed), 4);
+            ccstAssertEqual(consumed, 5);
+            ccstAssertEqual(values[2], 300);
+            ccstAssertEqual(values[3], 3);
+
+            data = FromHexString("0102030405060708090A0B0CFFFFFFFFFFFFFFFF");
+            ccstAssertEqual(Varint_DecodeArray(data, values, 16, consumed), 12);
+            ccstAssertEqual(consumed, 12);
+            U64 values64[16];
+            ccstAssertEqual(Varint_DecodeArray(data, values64, 16, consumed), 12);
+            ccstAssertEqual(consumed, 12);
+        }
+
+        void testArrays()
+        {
+            // Generate values with mixed encoded lengths
+            std::vector<U64> values64;
+            std::vector<U32> values32;
+            ByteArray random = getTestRandomData(4000);
+            for (size_t i = 0; i + 8 <= random.size(); i += 8) {
+                U64 v = LoadLittleEndian<U64>(random.data() + i);
+                size_t bits = random[i] % 65;
+                v = bits < 64 ? v & ((1ULL << bits) - 1) : v;
+                if (random[i + 1] < 128) {
+                    // Keep many short values, to exercise the fast paths
+                    v &= 0x7F;
+                }
+                values64.push_back(v);
+                values32.push_back(static_cast<U32>(v));
+            }
+
+            ByteArray encoded64, encoded32;
+            Varint_EncodeArray(values64.data(), values64.size(), encoded64);
+            Varint_EncodeArray(values32.data(), values32.size(), encoded32);
+
+            // Compare with single value decoding, for various counts
+            for (size_t count = 0; count <= values64.size(); count += 37) {
+                std::vector<U64> decoded64(count + 1);
+                std::vector<U32> decoded32(count + 1);
+                size_t consumed64, consumed32;
+                ccstAssertEqual(Varint_DecodeArray(encoded64, decoded64.data(), count, consumed64), count);
+                ccstAssertEqual(Varint_DecodeArray(encoded32, decoded32.data(), count, consumed32), count);
+                bool equal = true;
+                size_t offset64 = 0, offset32 = 0;
+                for (size_t i = 0; i < count && equal; i++) {
+                    equal = decoded64[i] == values64[i] && decoded32[i] == values32[i];
+                    offset64 += Varint_EncodedSize(values64[i]);
+                    offset32 += Varint_EncodedSize(values32[i]);
+                }
+                ccstAssertTrue(equal);
+                ccstAssertEqual(consumed64, offset64);
+                ccstAssertEqual(consumed32, offset32);
+            }
+
+            // Whole array, plus one value more than available
+            std::vector<U64> decoded(values64.size() + 1);
+            size_t consumed;
+            ccstAssertEqual(Varint_DecodeArray(encoded64, decoded.data(), decoded.size(), consumed), values64.size());
+            ccstAssertEqual(consumed, encoded64.size());
+
+            // All single byte values
+            ByteArray short_values(100, 0x55);
+            std::vector<U32> decoded32(100);
+            ccstAssertEqual(Varint_DecodeArray(short_values, decoded32.data(), 100, consumed), 100);
+            ccstAssertEqual(consumed, 100);
+            ccstAssertEqual(decoded32[99], 0x55);
+        }
+
+        void testReaderWriter()
+        {
+            ByteArray data;
+            {
+                ByteWriter writer(data);
+                writer.writeVarint(300).writeU16(0xAABB).writeVarint(0xFFFFFFFFFFFFFFFFULL);
+                for (U32 i = 0; i < 20; i++) {
+                    writer.writeVarint(i * 100);
+                }
+            }
+            ByteReader reader(data);
+            U32 v32;
+            U64 v64;
+            U16 v16;
+            ccstAssertTrue(reader.readVarint(v32));
+            ccstAssertEqual(v32, 300);
+            ccstAssertTrue(reader.readU16(v16));
+            ccstAssertEqual(v16, 0xAABB);
+            ccstAssertFalse(reader.readVarint(v32));
+            ccstAssertTrue(reader.readVarint(v64));
+            ccstAssertEqual(v64, 0xFFFFFFFFFFFFFFFFULL);
+            U32 values[21];
+            ccstAssertFalse(reader.readVarints(values, 21));
+            ccstAssertTrue(reader.readVarints(values, 20));
+            ccstAssertEqual(values[19], 1900);
+            ccstAssertTrue(reader.atEnd());
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7VarintTests, "cc7")
+
+} // cc7::tests
+} // cc7
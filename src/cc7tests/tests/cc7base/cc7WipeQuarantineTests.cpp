@@ -0,0 +1,176 @@
+/*
+ * Copyright 2016 Juraj Durech <durech.juraj@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cc7tests/CC7Tests.h>
+#include <cc7/WipeQuarantine.h>
+#include <atomic>
+#include <thread>
+
+namespace cc7
+{
+namespace tests
+{
+    // Release function for the test blocks. Checks whether the block
+    // is wiped and waits while the gate is closed.
+    static std::atomic<int> s_released_blocks;
+    static std::atomic<int> s_dirty_blocks;
+    static std::atomic<bool> s_gate_open;
+
+    static void _TestRelease(void * ptr, size_t size)
+    {
+        while (!s_gate_open.load()) {
+            std::this_thread::yield();
+        }
+        const cc7::byte * p = static_cast<const cc7::byte*>(ptr);
+        for (size_t i = 0; i < size; i++) {
+            if (p[i] != 0) {
+                s_dirty_blocks++;
+                break;
+            }
+        }
+        free(ptr);
+        s_released_blocks++;
+    }
+
+    static void * _AllocateDirty(size_t size)
+    {
+        void * ptr = malloc(size);
+        memset(ptr, 0xAA, size);
+        return ptr;
+    }
+
+    class cc7WipeQuarantineTests : public UnitTest
+    {
+    public:
+        cc7WipeQuarantineTests()
+        {
+            CC7_REGISTER_TEST_METHOD(testDisabled)
+            CC7_REGISTER_TEST_METHOD(testSubmitAndFlush)
+            CC7_REGISTER_TEST_METHOD(testLimit)
+            CC7_REGISTER_TEST_METHOD(testByteArray)
+        }
+
+        void tearDown() override
+        {
+            s_gate_open = true;
+            WipeQuarantine::disable();
+        }
+
+        // Unit tests
+
+        void testDisabled()
+        {
+            ccstAssertFalse(WipeQuarantine::isEnabled());
+            void * ptr = _AllocateDirty(WipeQuarantine::MIN_BLOCK_SIZE);
+            ccstAssertFalse(WipeQuarantine::submit(ptr, WipeQuarantine::MIN_BLOCK_SIZE, _TestRelease));
+            free(ptr);
+            // Flush does nothing
+            WipeQuarantine::flush();
+        }
+
+        void testSubmitAndFlush()
+        {
+            s_released_blocks = 0;
+            s_dirty_blocks = 0;
+            s_gate_open = true;
+
+            WipeQuarantine::Configuration config;
+            config.min_block_size = 0;
+            WipeQuarantine::enable(config);
+            ccstAssertTrue(WipeQuarantine::isEnabled());
+            WipeQuarantine::Statistics s0 = WipeQuarantine::statistics();
+
+            // Too small block
+            void * small = _AllocateDirty(1024);
+            ccstAssertFalse(WipeQuarantine::submit(small, 1024, _TestRelease));
+            free(small);
+
+            const size_t size = WipeQuarantine::MIN_BLOCK_SIZE;
+            for (int i = 0; i < 16; i++) {
+                ccstAssertTrue(WipeQuarantine::submit(_AllocateDirty(size), size, _TestRelease));
+            }
+            WipeQuarantine::flush();
+            ccstAssertEqual(s_released_blocks.load(), 16);
+            ccstAssertEqual(s_dirty_blocks.load(), 0);
+
+            WipeQuarantine::Statistics s1 = WipeQuarantine::statistics();
+            ccstAssertEqual(s1.deferred_blocks - s0.deferred_blocks, 16);
+            ccstAssertEqual(s1.deferred_bytes - s0.deferred_bytes, 16 * size);
+            ccstAssertEqual(s1.released_blocks - s0.released_blocks, 16);
+            ccstAssertEqual(s1.pending_bytes, 0);
+
+            // Disable processes all pending blocks
+            for (int i = 0; i < 4; i++) {
+                ccstAssertTrue(WipeQuarantine::submit(_AllocateDirty(size), size, _TestRelease));
+            }
+            WipeQuarantine::disable();
+            ccstAssertFalse(WipeQuarantine::isEnabled());
+            ccstAssertEqual(s_released_blocks.load(), 20);
+            ccstAssertEqual(s_dirty_blocks.load(), 0);
+        }
+
+        void testLimit()
+        {
+            s_released_blocks = 0;
+            s_gate_open = false;
+
+            const size_t size = WipeQuarantine::MIN_BLOCK_SIZE;
+            WipeQuarantine::Configuration config;
+            config.min_block_size = size;
+            config.max_pending_bytes = 3 * size;
+            WipeQuarantine::enable(config);
+            WipeQuarantine::Statistics s0 = WipeQuarantine::statistics();
+
+            // The background thread is blocked in the release function,
+            // so the blocks stay in the quarantine.
+            for (int i = 0; i < 3; i++) {
+                ccstAssertTrue(WipeQuarantine::submit(_AllocateDirty(size), size, _TestRelease));
+            }
+            void * rejected = _AllocateDirty(size);
+            ccstAssertFalse(WipeQuarantine::submit(rejected, size, _TestRelease));
+            free(rejected);
+
+            WipeQuarantine::Statistics s1 = WipeQuarantine::statistics();
+            ccstAssertEqual(s1.rejected_blocks - s0.rejected_blocks, 1);
+            ccstAssertEqual(s1.pending_bytes, 3 * size);
+            ccstAssertTrue(s1.peak_pending_bytes >= 3 * size);
+
+            s_gate_open = true;
+            WipeQuarantine::flush();
+            ccstAssertEqual(s_released_blocks.load(), 3);
+            ccstAssertEqual(WipeQuarantine::statistics().pending_bytes, 0);
+        }
+
+        void testByteArray()
+        {
+            WipeQuarantine::enable();
+            WipeQuarantine::Statistics s0 = WipeQuarantine::statistics();
+            {
+                ByteArray large(2 * 1024 * 1024, 0xCC);
+                ByteArray small(1024, 0xCC);
+            }
+            WipeQuarantine::flush();
+            WipeQuarantine::Statistics s1 = WipeQuarantine::statistics();
+            ccstAssertEqual(s1.deferred_blocks - s0.deferred_blocks, 1);
+            ccstAssertEqual(s1.released_blocks - s0.released_blocks, 1);
+            WipeQuarantine::disable();
+        }
+    };
+
+    CC7_CREATE_UNIT_TEST(cc7WipeQuarantineTests, "cc7")
+
+} // cc7::tests
+} // cc7